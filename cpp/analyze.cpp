@@ -0,0 +1,135 @@
+#include "chess/batchAnalysis.h"
+#include "chess/helpers.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Analyzes a list of positions, one FEN or EPD per line, on several threads
+// and prints each result as soon as its search finishes. EPD operations may
+// set the limits of a single position, see parseAnalysisLine.
+//
+// Usage: analyze [--threads N] [--depth N] [--nodes N] [--movetime MS]
+//                [--shared-table] [positions.epd]
+// Without a file the positions are read from standard input.
+
+struct Options {
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  bool sharedTable = false;
+  AnalysisLimits limits;
+  std::string input;
+};
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if (argument == "--shared-table") {
+      options.sharedTable = true;
+    } else if ((argument == "--threads" || argument == "--depth" ||
+                argument == "--nodes" || argument == "--movetime") &&
+               i + 1 < argc) {
+      const auto value = std::stol(argv[++i]);
+      if (argument == "--threads") {
+        options.threads = std::max(1L, value);
+      } else if (argument == "--depth") {
+        options.limits.maxDepth = static_cast<int>(value);
+      } else if (argument == "--nodes") {
+        options.limits.nodeLimit = value;
+      } else {
+        options.limits.milliseconds = static_cast<int>(value);
+      }
+    } else if (options.input.empty() && argument.rfind("--", 0) != 0) {
+      options.input = argument;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void print(const AnalysisResult &result) {
+  std::cout << result.index + 1;
+  if (!result.id.empty()) {
+    std::cout << " id \"" << result.id << "\"";
+  }
+  if (!result.valid) {
+    std::cout << " invalid " << result.fen << std::endl;
+    return;
+  }
+
+  std::cout << " bestmove ";
+  if (result.bestMove == Move(0, 0, 0, 0)) {
+    std::cout << "none";
+  } else {
+    std::cout << moveToCoordinates(result.bestMove);
+  }
+  if (result.line.mateIn != 0) {
+    std::cout << " mate " << result.line.mateIn;
+  } else {
+    std::cout << " cp " << result.line.centipawns;
+  }
+  std::cout << " depth " << result.stats.depth << " nodes "
+            << result.stats.nodes << " time " << result.stats.milliseconds
+            << " pv";
+  for (const auto &move : result.line.moves) {
+    std::cout << " " << moveToCoordinates(move);
+  }
+  std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::cerr << "Usage: analyze [--threads N] [--depth N] [--nodes N] "
+                 "[--movetime MS] [--shared-table] [positions.epd]"
+              << std::endl;
+    return 1;
+  }
+
+  std::ifstream file;
+  if (!options.input.empty()) {
+    file.open(options.input);
+    if (!file) {
+      std::cerr << "Could not open " << options.input << std::endl;
+      return 1;
+    }
+  }
+  std::istream &input = options.input.empty() ? std::cin : file;
+
+  long positions = 0;
+  long nodes = 0;
+  const auto startTime = std::chrono::steady_clock::now();
+  ThreadPool pool(options.threads);
+  BatchAnalysis analysis(pool, options.sharedTable,
+                         [&](const AnalysisResult &result) {
+                           positions++;
+                           nodes += result.stats.nodes;
+                           print(result);
+                         });
+
+  std::string line;
+  AnalysisRequest request;
+  std::size_t index = 0;
+  while (std::getline(input, line)) {
+    if (parseAnalysisLine(line, options.limits, request)) {
+      request.index = index;
+      analysis.add(request);
+    }
+    index++;
+  }
+  analysis.finish();
+
+  const auto seconds = std::max(
+      std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                    startTime)
+          .count(),
+      1e-6);
+  std::cout << "===========================" << std::endl;
+  std::cout << "Threads         : " << analysis.getThreadCount() << std::endl;
+  std::cout << "Positions       : " << positions << std::endl;
+  std::cout << "Total time (s)  : " << seconds << std::endl;
+  std::cout << "Nodes/second    : " << static_cast<long>(nodes / seconds)
+            << std::endl;
+  std::cout << "Positions/second: " << positions / seconds << std::endl;
+  std::cout << "Per thread      : "
+            << positions / seconds / analysis.getThreadCount() << std::endl;
+}
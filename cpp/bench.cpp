@@ -0,0 +1,62 @@
+#include "chess/computer.h"
+#include "chess/helpers.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Searches a fixed set of positions to a fixed depth. The total node count is
+// a signature of the search: a change that should not alter the search must
+// leave it untouched, while the nodes per second show whether it got faster.
+// Usage: bench [depth]
+
+const std::vector<std::string> benchPositions = {
+    "",
+    "e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6",
+    "d2-d4 d7-d5 c2-c4 e7-e6 Knb1-c3 Kng8-f6 Bc1-g5 Bf8-e7",
+    "e2-e4 c7-c5 Kng1-f3 d7-d6 d2-d4 c5-d4 Knf3-d4 Kng8-f6 Knb1-c3 a7-a6",
+    "e2-e4 e7-e5 Qd1-h5 Knb8-c6 Bf1-c4 Kng8-f6",
+    "e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6 d2-d4 e5-d4 e4-e5 d7-d5 "
+    "Bc4-b5 Knf6-e4",
+    "c2-c4 e7-e5 Knb1-c3 Kng8-f6 g2-g3 d7-d5 c4-d5 Knf6-d5 Bf1-g2 Knd5-b6",
+    "e2-e4 d7-d5 e4-d5 Qd8-d5 Knb1-c3 Qd5-a5 d2-d4 Kng8-f6 Kng1-f3 c7-c6",
+};
+
+std::shared_ptr<Board> boardAfter(const std::string &moves) {
+  auto board = std::make_shared<Board>();
+  board->setPromotionType(QUEEN);
+  auto convertedMoves = stringToMoves(moves);
+  while (!convertedMoves.empty()) {
+    auto move = convertedMoves.front();
+    convertedMoves.pop();
+    board->calcAndGetLegalMoves(move.startRow, move.startCol);
+    board->makeAMove(move.startRow, move.startCol, move.endRow, move.endCol);
+  }
+  return board;
+}
+
+int main(int argc, char *argv[]) {
+  const int depth = argc > 1 ? std::stoi(argv[1]) : 5;
+
+  long totalNodes = 0;
+  long totalMilliseconds = 0;
+  for (std::size_t i = 0; i < benchPositions.size(); i++) {
+    auto board = boardAfter(benchPositions[i]);
+    Computer computer(board, board->getTurn(), std::chrono::milliseconds(0));
+    computer.setSeed(0);
+    computer.setSearchLimits(depth, 0);
+
+    const auto move = computer.findMove();
+    const auto stats = computer.getStats();
+    totalNodes += stats.nodes;
+    totalMilliseconds += stats.milliseconds;
+    std::cout << "Position " << i + 1 << ": " << stats.nodes << " nodes, move "
+              << move.startRow << move.startCol << "-" << move.endRow
+              << move.endCol << std::endl;
+  }
+
+  std::cout << "===========================" << std::endl;
+  std::cout << "Total time (ms) : " << totalMilliseconds << std::endl;
+  std::cout << "Nodes searched  : " << totalNodes << std::endl;
+  std::cout << "Nodes/second    : "
+            << totalNodes * 1000 / std::max(totalMilliseconds, 1L) << std::endl;
+}
@@ -0,0 +1,179 @@
+#include "batchAnalysis.h"
+
+static std::string_view trim(std::string_view text) {
+  while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && (text.back() == ' ' || text.back() == '\t' ||
+                           text.back() == '\r' || text.back() == '\n')) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+static bool isNumber(std::string_view text) {
+  return !text.empty() && text.size() <= 9 &&
+         std::all_of(begin(text), end(text),
+                     [](char c) { return c >= '0' && c <= '9'; });
+}
+
+static long toNumber(std::string_view text) {
+  long number = 0;
+  for (auto c : text) {
+    number = number * 10 + c - '0';
+  }
+  return number;
+}
+
+// Finds where the next space separated field of line ends, starting at
+// position.
+static std::size_t fieldEnd(std::string_view line, std::size_t position) {
+  position = line.find_first_not_of(' ', position);
+  if (position == std::string_view::npos) {
+    return line.size();
+  }
+  const auto end = line.find(' ', position);
+  return end == std::string_view::npos ? line.size() : end;
+}
+
+static void applyOperation(std::string_view operation,
+                           AnalysisRequest &request) {
+  operation = trim(operation);
+  const auto space = operation.find(' ');
+  if (space == std::string_view::npos) {
+    return;
+  }
+  const auto opcode = operation.substr(0, space);
+  auto operand = trim(operation.substr(space + 1));
+  if (opcode == "id") {
+    if (operand.size() >= 2 && operand.front() == '"' &&
+        operand.back() == '"') {
+      operand = operand.substr(1, operand.size() - 2);
+    }
+    request.id = std::string(operand);
+  } else if (!isNumber(operand)) {
+    return;
+  } else if (opcode == "depth") {
+    request.limits.maxDepth = static_cast<int>(toNumber(operand));
+  } else if (opcode == "nodes") {
+    request.limits.nodeLimit = toNumber(operand);
+  } else if (opcode == "movetime") {
+    request.limits.milliseconds = static_cast<int>(toNumber(operand));
+  }
+}
+
+// The first four fields are the position. A FEN follows them with the two
+// clocks, an EPD with its operations, each ended by a semicolon.
+bool parseAnalysisLine(std::string_view line, const AnalysisLimits &defaults,
+                       AnalysisRequest &request) {
+  line = trim(line);
+  if (line.empty() || line.front() == '#') {
+    return false;
+  }
+
+  request.id.clear();
+  request.limits = defaults;
+
+  std::size_t positionEnd = 0;
+  for (int field = 0; field < 4; field++) {
+    positionEnd = fieldEnd(line, positionEnd);
+  }
+  const auto halfmoveEnd = fieldEnd(line, positionEnd);
+  const auto fullmoveEnd = fieldEnd(line, halfmoveEnd);
+  if (isNumber(trim(line.substr(positionEnd, halfmoveEnd - positionEnd))) &&
+      isNumber(trim(line.substr(halfmoveEnd, fullmoveEnd - halfmoveEnd)))) {
+    positionEnd = fullmoveEnd;
+  }
+  request.fen = std::string(line.substr(0, positionEnd));
+
+  auto operations = line.substr(positionEnd);
+  while (!operations.empty()) {
+    auto length = operations.find(';');
+    if (length == std::string_view::npos) {
+      length = operations.size();
+    }
+    applyOperation(operations.substr(0, length), request);
+    operations.remove_prefix(std::min(length + 1, operations.size()));
+  }
+  return true;
+}
+
+AnalysisResult analyzePosition(const AnalysisRequest &request,
+                               std::shared_ptr<TranspositionTable> table) {
+  AnalysisResult result;
+  result.index = request.index;
+  result.id = request.id;
+  result.fen = request.fen;
+
+  const auto board = Board::fromFEN(request.fen);
+  if (!board) {
+    return result;
+  }
+  result.valid = true;
+
+  Computer computer(board, board->getTurn(),
+                    std::chrono::milliseconds(request.limits.milliseconds));
+  if (request.limits.milliseconds <= 0) {
+    computer.setSearchLimits(request.limits.maxDepth, request.limits.nodeLimit);
+  }
+  computer.setSeed(0);
+  computer.setTable(table);
+
+  result.bestMove = computer.findMove();
+  const auto lines = computer.getLines();
+  if (!lines.empty()) {
+    result.line = lines.front();
+  }
+  result.stats = computer.getStats();
+  return result;
+}
+
+BatchAnalysis::BatchAnalysis(ThreadPool &pool, bool shareTable,
+                             AnalysisCallback callback)
+    : pool(pool), callback(callback),
+      workerTables(pool.getThreadCount()),
+      queueLimit(4 * pool.getThreadCount()) {
+  if (shareTable) {
+    sharedTable = std::make_shared<TranspositionTable>();
+  }
+}
+
+BatchAnalysis::~BatchAnalysis() { finish(); }
+
+void BatchAnalysis::add(AnalysisRequest request) {
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    positionDone.wait(lock, [this]() { return unfinished < queueLimit; });
+    unfinished++;
+  }
+  pool.submit([this, request]() { analyze(request); }, TaskPriority::BATCH);
+}
+
+void BatchAnalysis::finish() {
+  std::unique_lock<std::mutex> lock(mutex);
+  positionDone.wait(lock, [this]() { return unfinished == 0; });
+}
+
+int BatchAnalysis::getThreadCount() const { return pool.getThreadCount(); }
+
+// Only the worker with the index uses its table, so the tables need no lock.
+void BatchAnalysis::analyze(const AnalysisRequest &request) {
+  auto table = sharedTable;
+  if (!table) {
+    auto &workerTable = workerTables[pool.getWorkerIndex()];
+    if (!workerTable) {
+      workerTable = std::make_shared<TranspositionTable>();
+    }
+    table = workerTable;
+  }
+
+  const auto result = analyzePosition(request, table);
+  {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    callback(result);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  unfinished--;
+  positionDone.notify_all();
+}
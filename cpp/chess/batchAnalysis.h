@@ -0,0 +1,86 @@
+#ifndef BATCH_ANALYSIS_H
+#define BATCH_ANALYSIS_H
+#include "computer.h"
+#include "threadPool.h"
+#include <condition_variable>
+#include <string_view>
+
+// How long one position is searched. A time limit, in milliseconds, replaces
+// the depth and node limits.
+struct AnalysisLimits {
+  int maxDepth = 8;
+  long nodeLimit = 0;
+  int milliseconds = 0;
+};
+
+// A position to analyze. index is its place in the input, id its EPD id.
+struct AnalysisRequest {
+  std::size_t index = 0;
+  std::string id;
+  std::string fen;
+  AnalysisLimits limits;
+};
+
+// valid is false when the FEN could not be read, the rest is then empty.
+struct AnalysisResult {
+  std::size_t index = 0;
+  std::string id;
+  std::string fen;
+  bool valid = false;
+  Move bestMove = Move(0, 0, 0, 0);
+  AnalysisLine line;
+  SearchStats stats;
+};
+
+using AnalysisCallback = std::function<void(const AnalysisResult &)>;
+
+// Reads a line holding a FEN, or an EPD whose operations may set the limits
+// of the position: "id", "depth", "nodes" and "movetime", other operations
+// are ignored. Limits the line leaves out are taken from defaults. Returns
+// false for empty lines and lines starting with '#'.
+bool parseAnalysisLine(std::string_view line, const AnalysisLimits &defaults,
+                       AnalysisRequest &request);
+
+AnalysisResult analyzePosition(const AnalysisRequest &request,
+                               std::shared_ptr<TranspositionTable> table);
+
+// Analyzes positions as batch tasks of a thread pool, each searching with its
+// own Computer. Every result is handed to the callback as soon as its search
+// finishes, so not in the order the positions were added, but one at a time.
+class BatchAnalysis {
+private:
+  ThreadPool &pool;
+  AnalysisCallback callback;
+  std::shared_ptr<TranspositionTable> sharedTable;
+  std::vector<std::shared_ptr<TranspositionTable>> workerTables;
+  std::size_t queueLimit;
+  std::mutex mutex;
+  std::condition_variable positionDone;
+  std::size_t unfinished = 0;
+  std::mutex callbackMutex;
+
+  void analyze(const AnalysisRequest &request);
+
+public:
+  // With shareTable all workers search with one transposition table, which
+  // pays off when the positions come from the same games. Otherwise each
+  // worker has its own.
+  BatchAnalysis(ThreadPool &pool, bool shareTable, AnalysisCallback callback);
+
+  ~BatchAnalysis();
+
+  BatchAnalysis(const BatchAnalysis &) = delete;
+  BatchAnalysis &operator=(const BatchAnalysis &) = delete;
+
+  // Blocks while a few positions per worker are already waiting, so a long
+  // input is not read into memory all at once. Must not be called from a
+  // task of the pool.
+  void add(AnalysisRequest request);
+
+  // Waits until every added position has been analyzed.
+  void finish();
+
+  int getThreadCount() const;
+};
+
+#endif // BATCH_ANALYSIS_H
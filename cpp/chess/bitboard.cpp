@@ -0,0 +1,131 @@
+#include "bitboard.h"
+#include "helpers.h"
+
+void PieceBitboards::addPiece(int color, int type, int square) {
+  pieces[color][type] |= bitboard::squareBit(square);
+  colors[color] |= bitboard::squareBit(square);
+}
+
+void PieceBitboards::removePiece(int color, int type, int square) {
+  pieces[color][type] &= ~bitboard::squareBit(square);
+  colors[color] &= ~bitboard::squareBit(square);
+}
+
+namespace bitboard {
+
+constexpr int DIRECTION_COUNT = 8;
+
+// Everything here only depends on the square, so it is computed once. Rays
+// run from a square to the edge of the board, not including the square.
+struct AttackTables {
+  Bitboard knight[SQUARE_COUNT];
+  Bitboard king[SQUARE_COUNT];
+  Bitboard pawn[COLOR_COUNT][SQUARE_COUNT];
+  Bitboard rays[DIRECTION_COUNT][SQUARE_COUNT];
+
+  AttackTables() {
+    for (int row = 0; row < BOARD_LENGTH; row++) {
+      for (int col = 0; col < BOARD_LENGTH; col++) {
+        const auto square = toSquareIndex(row, col);
+
+        knight[square] = calcSteps(knightMovement, row, col);
+        king[square] = calcSteps(queenMovement, row, col);
+        pawn[WHITE_INDEX][square] = calcSteps({{-1, -1}, {-1, 1}}, row, col);
+        pawn[BLACK_INDEX][square] = calcSteps({{1, -1}, {1, 1}}, row, col);
+
+        for (int direction = 0; direction < DIRECTION_COUNT; direction++) {
+          rays[direction][square] =
+              calcRay(queenMovement[direction], row, col);
+        }
+      }
+    }
+  }
+
+  static Bitboard calcSteps(const std::vector<Movement> &movements, int row,
+                            int col) {
+    Bitboard bits = 0;
+    for (const auto &movement : movements) {
+      const auto currentRow = row + movement.rowDiff;
+      const auto currentCol = col + movement.colDiff;
+      if (isInsideBoard(currentRow, currentCol)) {
+        bits |= squareBit(toSquareIndex(currentRow, currentCol));
+      }
+    }
+    return bits;
+  }
+
+  static Bitboard calcRay(const Movement &movement, int row, int col) {
+    Bitboard bits = 0;
+    auto currentRow = row + movement.rowDiff;
+    auto currentCol = col + movement.colDiff;
+    while (isInsideBoard(currentRow, currentCol)) {
+      bits |= squareBit(toSquareIndex(currentRow, currentCol));
+      currentRow += movement.rowDiff;
+      currentCol += movement.colDiff;
+    }
+    return bits;
+  }
+};
+
+static const AttackTables tables;
+
+// A ray stops at the first piece it meets, that piece is still attacked.
+static Bitboard rayAttacks(int direction, int square, Bitboard occupied) {
+  const auto &movement = queenMovement[direction];
+  const auto ray = tables.rays[direction][square];
+  const auto blockers = ray & occupied;
+  if (blockers == 0) {
+    return ray;
+  }
+
+  const auto increasesIndex =
+      movement.rowDiff * BOARD_LENGTH + movement.colDiff > 0;
+  const auto blocker = increasesIndex ? lowestSquare(blockers)
+                                      : 63 - __builtin_clzll(blockers);
+  return ray & ~tables.rays[direction][blocker];
+}
+
+Bitboard knightAttacks(int square) { return tables.knight[square]; }
+
+Bitboard kingAttacks(int square) { return tables.king[square]; }
+
+Bitboard pawnAttacks(int color, int square) {
+  return tables.pawn[color][square];
+}
+
+// queenMovement lists the four rook directions first, then the diagonals.
+Bitboard rookAttacks(int square, Bitboard occupied) {
+  Bitboard attacks = 0;
+  for (int direction = 0; direction < 4; direction++) {
+    attacks |= rayAttacks(direction, square, occupied);
+  }
+  return attacks;
+}
+
+Bitboard bishopAttacks(int square, Bitboard occupied) {
+  Bitboard attacks = 0;
+  for (int direction = 4; direction < DIRECTION_COUNT; direction++) {
+    attacks |= rayAttacks(direction, square, occupied);
+  }
+  return attacks;
+}
+
+Bitboard pieceAttacks(int color, int type, int square, Bitboard occupied) {
+  switch (type) {
+  case PAWN_INDEX:
+    return pawnAttacks(color, square);
+  case KNIGHT_INDEX:
+    return knightAttacks(square);
+  case BISHOP_INDEX:
+    return bishopAttacks(square, occupied);
+  case ROOK_INDEX:
+    return rookAttacks(square, occupied);
+  case QUEEN_INDEX:
+    return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+  case KING_INDEX:
+    return kingAttacks(square);
+  }
+  return 0;
+}
+
+} // namespace bitboard
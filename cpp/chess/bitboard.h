@@ -0,0 +1,45 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+#include "constants.h"
+
+// One bitboard per color and piece type, plus the occupancy of each color.
+// Bit row * BOARD_LENGTH + col is set when that square holds the piece.
+struct PieceBitboards {
+  Bitboard pieces[COLOR_COUNT][PIECE_TYPE_COUNT] = {};
+  Bitboard colors[COLOR_COUNT] = {};
+
+  Bitboard occupied() const { return colors[WHITE_INDEX] | colors[BLACK_INDEX]; }
+  void addPiece(int color, int type, int square);
+  void removePiece(int color, int type, int square);
+};
+
+namespace bitboard {
+
+inline Bitboard squareBit(int square) { return Bitboard(1) << square; }
+
+inline int lowestSquare(Bitboard bits) { return __builtin_ctzll(bits); }
+
+inline int popLowestSquare(Bitboard &bits) {
+  const int square = lowestSquare(bits);
+  bits &= bits - 1;
+  return square;
+}
+
+inline int countBits(Bitboard bits) { return __builtin_popcountll(bits); }
+
+Bitboard knightAttacks(int square);
+
+Bitboard kingAttacks(int square);
+
+// Squares a pawn of the given color standing on square attacks.
+Bitboard pawnAttacks(int color, int square);
+
+Bitboard bishopAttacks(int square, Bitboard occupied);
+
+Bitboard rookAttacks(int square, Bitboard occupied);
+
+Bitboard pieceAttacks(int color, int type, int square, Bitboard occupied);
+
+} // namespace bitboard
+
+#endif // BITBOARD_H
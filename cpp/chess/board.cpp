@@ -1,4 +1,6 @@
 #include "board.h"
+#include <cctype>
+#include <cstdlib>
 
 Board::Board(std::shared_ptr<Board> boardPtr) {
 
@@ -7,7 +9,12 @@ Board::Board(std::shared_ptr<Board> boardPtr) {
   history = boardPtr->history;
   promotionType = boardPtr->promotionType;
   gameStatus = boardPtr->gameStatus;
-  positions = boardPtr->positions;
+  positionHashes = boardPtr->positionHashes;
+  bitboards = boardPtr->bitboards;
+  hash = boardPtr->hash;
+  startHalfmoveClock = boardPtr->startHalfmoveClock;
+  startPly = boardPtr->startPly;
+  setupMoveCount = boardPtr->setupMoveCount;
 }
 
 Board::Board() {
@@ -82,13 +89,19 @@ Board::Board() {
 
   // Lets white start
   turn = WHITE;
+
+  calcPieceBitboards();
+  calcHash();
 }
 
 Board::Board(std::vector<std::vector<Square>> squares,
              std::vector<Square> legalMoves, std::string turn,
              Square currentSquare, std::vector<Move> history)
     : squares(squares), legalMoves(legalMoves), turn(turn),
-      currentSquare(currentSquare), history(history) {}
+      currentSquare(currentSquare), history(history) {
+  calcPieceBitboards();
+  calcHash();
+}
 
 std::vector<Square>
 Board::findLegalMoves(const std::vector<Square> &possibleMoves,
@@ -97,8 +110,7 @@ Board::findLegalMoves(const std::vector<Square> &possibleMoves,
   std::vector<Square> moves;
   Square kingSquare = findKing(kingColor);
   for (auto possibleMove : possibleMoves) {
-    bool illegalMove =
-        isMoveIllegal(kingSquare, takoffSquare, possibleMove, possibleMoves);
+    bool illegalMove = isMoveIllegal(kingSquare, takoffSquare, possibleMove);
     if (!illegalMove) {
       moves.emplace_back(possibleMove);
     }
@@ -106,69 +118,62 @@ Board::findLegalMoves(const std::vector<Square> &possibleMoves,
   return moves;
 }
 
-bool Board::isMoveIllegal(Square kingSquare, Square currentSquare,
-                          Square possibleMove,
-                          const std::vector<Square> &possibleMoves) {
-  const auto &type = currentSquare.getPiece().getType();
-  const auto &row = currentSquare.getRow();
-  const auto &col = currentSquare.getCol();
+// Plays the move on a copy of the bitboards only and checks whether the
+// mover's king is attacked afterwards.
+bool Board::isMoveIllegal(const Square &kingSquare,
+                          const Square &takeOffSquare,
+                          const Square &possibleMove) const {
+  const auto &piece = takeOffSquare.getPiece();
+  const auto side = colorToIndex(turn);
+  const auto opponent = side == WHITE_INDEX ? BLACK_INDEX : WHITE_INDEX;
+  const auto type = pieceTypeToIndex(piece.getType());
+  const auto from = toSquareIndex(takeOffSquare.getRow(), takeOffSquare.getCol());
+  const auto to = toSquareIndex(possibleMove.getRow(), possibleMove.getCol());
+
+  if (type != KING_INDEX && kingSquare.getRow() < 0) {
+    return false;
+  }
 
-  auto newBoard = Board(squares, possibleMoves, turn, currentSquare, history);
-  newBoard.movePiece(row, col, possibleMove.getRow(), possibleMove.getCol());
+  auto after = bitboards;
+  const auto &targetPiece =
+      squares[possibleMove.getRow()][possibleMove.getCol()].getPiece();
+  if (targetPiece.getType() != "") {
+    after.removePiece(opponent, pieceTypeToIndex(targetPiece.getType()), to);
+  } else if (type == PAWN_INDEX &&
+             takeOffSquare.getCol() != possibleMove.getCol()) {
+    after.removePiece(
+        opponent, PAWN_INDEX,
+        toSquareIndex(takeOffSquare.getRow(), possibleMove.getCol()));
+  }
+  after.removePiece(side, type, from);
+  after.addPiece(side, type, to);
 
   // the problem is if the king tries to move, but we have set that king is
   // still in place.
-  if (type == KING) {
-    kingSquare = possibleMove;
-  }
-
-  auto hitsKingSquare = [kingSquare](Square s) {
-    return s.getRow() == kingSquare.getRow() &&
-           s.getCol() == kingSquare.getCol();
-  };
+  const auto king = type == KING_INDEX
+                        ? to
+                        : toSquareIndex(kingSquare.getRow(), kingSquare.getCol());
 
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      auto newSquare = newBoard.squares[i][j];
-      auto newType = newSquare.getPiece().getType();
-      auto newColor = newSquare.getPiece().getColor();
-      if (newType != "" && newColor != turn) {
-        std::vector<Square> tempPossibleMoves =
-            newBoard.findPossibleMoves(newSquare, true);
-
-        auto kingIsAttacked =
-            find_if(begin(tempPossibleMoves), end(tempPossibleMoves),
-                    hitsKingSquare) != end(tempPossibleMoves);
-
-        if (kingIsAttacked) {
-          return true;
-        }
-      }
-    }
-  }
-  return false;
+  return (attackersTo(king, after.occupied(), after) &
+          after.colors[opponent]) != 0;
 }
 
-Square Board::findKing(std::string color) {
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      if (squares[i][j].getPiece().getType() == KING &&
-          squares[i][j].getPiece().getColor() == color) {
-        return squares[i][j];
-      }
-    }
+Square Board::findKing(const std::string &color) const {
+  const auto king = bitboards.pieces[colorToIndex(color)][KING_INDEX];
+  if (king == 0) {
+    return Square();
   }
-  return Square();
+  const auto square = bitboard::lowestSquare(king);
+  return squares[square / BOARD_LENGTH][square % BOARD_LENGTH];
 }
 
-std::vector<Square> Board::findPossibleMoves(const Square &takeOffSquare,
-                                             bool controllMode) {
+std::vector<Square> Board::findPossibleMoves(const Square &takeOffSquare) {
 
   std::vector<Square> possibleMoves;
 
   const auto &type = takeOffSquare.getPiece().getType();
   if (type == PAWN) {
-    findPossiblePawnMoves(possibleMoves, takeOffSquare, controllMode);
+    findPossiblePawnMoves(possibleMoves, takeOffSquare);
   }
 
   if (type == BISHOP) {
@@ -188,31 +193,26 @@ std::vector<Square> Board::findPossibleMoves(const Square &takeOffSquare,
   }
 
   if (type == KING) {
-    findPossibleKingMoves(possibleMoves, takeOffSquare, controllMode);
+    findPossibleKingMoves(possibleMoves, takeOffSquare);
   }
 
   return possibleMoves;
 }
 
 void Board::findPossiblePawnMoves(std::vector<Square> &possibleMoves,
-                                  const Square &takeOffSquare,
-                                  bool controllMode) {
+                                  const Square &takeOffSquare) {
 
   const auto &row = takeOffSquare.getRow();
   const auto &col = takeOffSquare.getCol();
   const auto &pieceColor = takeOffSquare.getPiece().getColor();
   const int rowMultiplier = pieceColor == WHITE ? -1 : 1;
 
-  addPawnStep(possibleMoves, takeOffSquare, controllMode);
+  addPawnStep(possibleMoves, takeOffSquare);
 
-  addPawnCapture(row + rowMultiplier, col - 1, possibleMoves, takeOffSquare,
-                 controllMode);
-  addPawnCapture(row + rowMultiplier, col + 1, possibleMoves, takeOffSquare,
-                 controllMode);
+  addPawnCapture(row + rowMultiplier, col - 1, possibleMoves, takeOffSquare);
+  addPawnCapture(row + rowMultiplier, col + 1, possibleMoves, takeOffSquare);
 
-  if (!controllMode) {
-    addEnPassant(possibleMoves, takeOffSquare);
-  }
+  addEnPassant(possibleMoves, takeOffSquare);
 }
 
 void Board::addEnPassant(std::vector<Square> &possibleMoves,
@@ -234,7 +234,7 @@ void Board::addEnPassant(std::vector<Square> &possibleMoves,
 }
 
 void Board::addPawnStep(std::vector<Square> &possibleMoves,
-                        Square takeOffSquare, bool controllMode) {
+                        Square takeOffSquare) {
 
   const auto &row = takeOffSquare.getRow();
   const auto &col = takeOffSquare.getCol();
@@ -247,7 +247,7 @@ void Board::addPawnStep(std::vector<Square> &possibleMoves,
   // can move one step
   const auto oneSquareInfront = squares[oneRow][col];
   auto canMoveOneStep = oneSquareInfront.getPiece().getType().empty();
-  if (canMoveOneStep && !controllMode) {
+  if (canMoveOneStep) {
     possibleMoves.emplace_back(oneSquareInfront);
   }
 
@@ -259,21 +259,19 @@ void Board::addPawnStep(std::vector<Square> &possibleMoves,
     auto canMoveTwoSteps =
         canMoveOneStep && twoSquaresInfront.getPiece().getType().empty();
 
-    if (canMoveTwoSteps && !controllMode) {
+    if (canMoveTwoSteps) {
       possibleMoves.emplace_back(twoSquaresInfront);
     }
   }
 }
 
 void Board::addPawnCapture(int row, int col, std::vector<Square> &possibleMoves,
-                           const Square &takeOffSquare,
-                           const bool &controllMode) {
+                           const Square &takeOffSquare) {
   const auto &pieceColor = takeOffSquare.getPiece().getColor();
   if (isInsideBoard(row, col)) {
     const auto leftSquare = squares[row][col];
     const auto leftPiece = leftSquare.getPiece();
-    if ((leftPiece.getColor() != pieceColor && leftPiece.getType() != "") ||
-        controllMode) {
+    if (leftPiece.getColor() != pieceColor && leftPiece.getType() != "") {
       possibleMoves.emplace_back(leftSquare);
     }
   }
@@ -340,22 +338,20 @@ void Board::findPossibleKnightMoves(std::vector<Square> &possibleMoves,
 }
 
 void Board::findPossibleKingMoves(std::vector<Square> &possibleMoves,
-                                  const Square &takeOffSquare,
-                                  bool controllMode) {
+                                  const Square &takeOffSquare) {
 
   auto color = takeOffSquare.getPiece().getColor();
+  auto opponentsColor = color == WHITE ? BLACK : WHITE;
 
-  auto controlledSquares = findControlledSquares(color, controllMode);
-
-  addKingMoves(possibleMoves, controlledSquares, takeOffSquare);
+  addKingMoves(possibleMoves, opponentsColor, takeOffSquare);
 
-  addShortCastle(possibleMoves, controlledSquares, takeOffSquare);
+  addShortCastle(possibleMoves, opponentsColor, takeOffSquare);
 
-  addLongCastle(possibleMoves, controlledSquares, takeOffSquare);
+  addLongCastle(possibleMoves, opponentsColor, takeOffSquare);
 }
 
 void Board::addKingMoves(std::vector<Square> &possibleMoves,
-                         const std::vector<Square> &controlledSquares,
+                         const std::string &opponentsColor,
                          const Square &takeOffSquare) {
   const auto &row = takeOffSquare.getRow();
   const auto &col = takeOffSquare.getCol();
@@ -364,11 +360,8 @@ void Board::addKingMoves(std::vector<Square> &possibleMoves,
     auto currentRow = row + movement.rowDiff;
     auto currentCol = col + movement.colDiff;
     auto squareIsControlled =
-        std::find_if(begin(controlledSquares), end(controlledSquares),
-                     [currentRow, currentCol](Square s) {
-                       return s.getRow() == currentRow &&
-                              s.getCol() == currentCol;
-                     }) != end(controlledSquares);
+        isInsideBoard(currentRow, currentCol) &&
+        isSquareAttacked(currentRow, currentCol, opponentsColor);
     if (!squareIsControlled) {
       addPossibleMove(currentRow, currentCol, possibleMoves, takeOffSquare);
     }
@@ -376,7 +369,7 @@ void Board::addKingMoves(std::vector<Square> &possibleMoves,
 }
 
 void Board::addShortCastle(std::vector<Square> &possibleMoves,
-                           const std::vector<Square> &controlledSquares,
+                           const std::string &opponentsColor,
                            const Square &takeOffSquare) {
 
   const auto &row = takeOffSquare.getRow();
@@ -387,20 +380,20 @@ void Board::addShortCastle(std::vector<Square> &possibleMoves,
                   squares[row][7].getPiece().getType() == ROOK;
   auto freeSpace = squares[row][5].getPiece().getType() == "" &&
                    squares[row][6].getPiece().getType() == "";
-  auto notControlled =
-      std::find_if(begin(controlledSquares), end(controlledSquares),
-                   [row](Square s) {
-                     return (s.getRow() == row && s.getCol() == 5) ||
-                            (s.getRow() == row && s.getCol() == 6) ||
-                            (s.getRow() == row && s.getCol() == 4);
-                   }) == end(controlledSquares);
-  if (notMoved && freeSpace && notControlled) {
+  if (!notMoved || !freeSpace) {
+    return;
+  }
+
+  auto notControlled = !isSquareAttacked(row, 4, opponentsColor) &&
+                       !isSquareAttacked(row, 5, opponentsColor) &&
+                       !isSquareAttacked(row, 6, opponentsColor);
+  if (notControlled) {
     possibleMoves.emplace_back(row, 6);
   }
 }
 
 void Board::addLongCastle(std::vector<Square> &possibleMoves,
-                          const std::vector<Square> &controlledSquares,
+                          const std::string &opponentsColor,
                           const Square &takeOffSquare) {
 
   const auto &row = takeOffSquare.getRow();
@@ -411,41 +404,22 @@ void Board::addLongCastle(std::vector<Square> &possibleMoves,
                   squares[row][0].getPiece().getType() == ROOK;
   auto freeSpace = squares[row][2].getPiece().getType() == "" &&
                    squares[row][3].getPiece().getType() == "";
-  auto notControlled =
-      std::find_if(begin(controlledSquares), end(controlledSquares),
-                   [row](Square s) {
-                     return (s.getRow() == row && s.getCol() == 2) ||
-                            (s.getRow() == row && s.getCol() == 3) ||
-                            (s.getRow() == row && s.getCol() == 4);
-                   }) == end(controlledSquares);
-  if (notMoved && freeSpace && notControlled) {
-    possibleMoves.emplace_back(row, 2);
-  }
-}
-
-std::vector<Square> Board::findControlledSquares(std::string color,
-                                                 bool controllMode) {
-  std::vector<Square> controlledSquares;
-  if (controllMode) {
-    return controlledSquares;
+  if (!notMoved || !freeSpace) {
+    return;
   }
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      auto square = squares[i][j];
-      auto currentColor = square.getPiece().getColor();
-      if (square.getPiece().getType() != "" && color != currentColor) {
-
-        auto controlled = findPossibleMoves(square, true);
 
-        controlledSquares.insert(end(controlledSquares), begin(controlled),
-                                 end(controlled));
-      }
-    }
+  auto notControlled = !isSquareAttacked(row, 2, opponentsColor) &&
+                       !isSquareAttacked(row, 3, opponentsColor) &&
+                       !isSquareAttacked(row, 4, opponentsColor);
+  if (notControlled) {
+    possibleMoves.emplace_back(row, 2);
   }
-  return controlledSquares;
 }
 
-void Board::changeTurn() { turn = turn == WHITE ? BLACK : WHITE; }
+void Board::changeTurn() {
+  turn = turn == WHITE ? BLACK : WHITE;
+  hash ^= zobrist::sideKey();
+}
 
 void Board::movePiece(int startRow, int startCol, int endRow, int endCol) {
 
@@ -458,13 +432,12 @@ void Board::movePiece(int startRow, int startCol, int endRow, int endCol) {
       moveEnPassant(startCol, endCol, pieceTypeOnLandingSquare);
 
   if (movedPiece.getType() == PAWN && (endRow == 0 || endRow == 7)) {
-    squares[endRow][endCol].replacePiece(
-        Piece(promotionType, movedPiece.getColor()));
+    replacePiece(endRow, endCol, Piece(promotionType, movedPiece.getColor()));
   } else {
-    squares[endRow][endCol].replacePiece(movedPiece);
+    replacePiece(endRow, endCol, movedPiece);
   }
 
-  squares[startRow][startCol].replacePiece(Piece());
+  replacePiece(startRow, startCol, Piece());
 
   const auto &pieceTypeMoved = currentSquare.getPiece().getType();
 
@@ -494,44 +467,14 @@ std::string Board::calcGameStatus() {
 
   auto opponentsColor = turn == WHITE ? BLACK : WHITE;
 
-  auto king = findKing(turn);
-  auto kingIsInCheck = false;
-  auto playerCanMove = false;
-  auto searchForKing = [king](Square s) {
-    return s.getRow() == king.getRow() && s.getCol() == king.getCol();
-  };
+  auto kingIsInCheck = isKingInCheck(turn);
 
-  auto yourMatingMaterial = 0;
-  auto opponentsMatingMaterial = 0;
+  auto playerCanMove = hasLegalMove();
 
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      const auto &square = squares[i][j];
-      const auto &piece = square.getPiece();
-
-      if (!kingIsInCheck) {
-        kingIsInCheck = isKingInCheck(square, opponentsColor, searchForKing);
-      }
-      if (piece.getColor() == turn && !playerCanMove) {
-        playerCanMove = canMove(square);
-      }
-      if (opponentsMatingMaterial < 3) {
-        opponentsMatingMaterial += calcMatingMaterial(piece, opponentsColor);
-      }
-      if (yourMatingMaterial < 3) {
-        opponentsMatingMaterial += calcMatingMaterial(piece, turn);
-      }
-    }
-  }
+  auto yourMatingMaterial = calcMatingMaterial(turn);
+  auto opponentsMatingMaterial = calcMatingMaterial(opponentsColor);
 
-  auto fiftyMoveRule = false;
-  if (history.size() > 100) {
-    auto pawnMoveOrCapture = [](Move m) {
-      return m.pieceTypeMoved == PAWN || m.pieceTypeCaptured != "";
-    };
-    fiftyMoveRule = find_if(end(history) - 100, end(history),
-                            pawnMoveOrCapture) == end(history);
-  }
+  auto fiftyMoveRule = calcHalfmoveClock() >= 100;
 
   const auto drawByRepetition = calcThreeFoldRepetition();
   if (drawByRepetition) {
@@ -543,7 +486,7 @@ std::string Board::calcGameStatus() {
   }
 
   auto suffcientMatingMaterial =
-      yourMatingMaterial > 2 || opponentsMatingMaterial > 2;
+      yourMatingMaterial + opponentsMatingMaterial > 2;
   if (!playerCanMove) {
     return DRAW_BY_STALEMATE;
   }
@@ -557,64 +500,38 @@ std::string Board::calcGameStatus() {
   return "";
 }
 
-bool Board::calcThreeFoldRepetition() {
-  std::string position = "";
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      const auto &type = squares[i][j].getPiece().getType();
-      if (type != "") {
-        position += type.at(0);
-        position += std::to_string(i);
-        position += std::to_string(j);
-      }
-    }
-  }
-  position += turn;
-  // We dont check for enpassant or castling rights
-
-  if (positions.count(position)) {
-    positions.at(position)++;
-    if (positions.at(position) >= 3) {
-      return true;
-    }
-  } else {
-    positions.insert({position, 1});
-  }
-  return false;
+// We dont check for enpassant or castling rights, the hash only covers the
+// pieces and the side to move.
+bool Board::calcThreeFoldRepetition() const {
+  return std::count(begin(positionHashes), end(positionHashes), hash) >= 3;
 }
 
-int Board::calcMatingMaterial(const Piece &piece, const std::string &color) {
-  if (piece.getColor() == color) {
-    return 0;
-  }
+void Board::recordPosition() { positionHashes.push_back(hash); }
 
-  if (piece.getType() == KNIGHT) {
-    return 1;
-  }
-  if (piece.getType() == BISHOP) {
-    return 2;
-  }
-  if (piece.getType() == QUEEN || piece.getType() == ROOK ||
-      piece.getType() == PAWN) {
-    return 3;
-  }
-  return 0;
+int Board::calcMatingMaterial(const std::string &color) const {
+  const auto &pieces = bitboards.pieces[colorToIndex(color)];
+  return bitboard::countBits(pieces[KNIGHT_INDEX]) +
+         2 * bitboard::countBits(pieces[BISHOP_INDEX]) +
+         3 * bitboard::countBits(pieces[QUEEN_INDEX] | pieces[ROOK_INDEX] |
+                                 pieces[PAWN_INDEX]);
 }
 
 bool Board::canMove(const Square &square) {
-  auto moves = findPossibleMoves(square, false);
-  return findLegalMoves(moves, turn, square).size() > 0;
+  auto moves = findPossibleMoves(square);
+  auto kingSquare = findKing(turn);
+  return std::any_of(begin(moves), end(moves),
+                     [this, &kingSquare, &square](const Square &move) {
+                       return !isMoveIllegal(kingSquare, square, move);
+                     });
 }
 
-bool Board::isKingInCheck(const Square &square, std::string opponentsColor,
-                          std::function<bool(Square s)> searchForKing) {
-  const auto &piece = square.getPiece();
-  if (piece.getColor() == opponentsColor && piece.getType() != "") {
-    auto controlledSquares = findPossibleMoves(square, true);
-    return find_if(begin(controlledSquares), end(controlledSquares),
-                   searchForKing) != end(controlledSquares);
+bool Board::isKingInCheck(const std::string &color) const {
+  auto king = findKing(color);
+  if (king.getRow() < 0) {
+    return false;
   }
-  return false;
+  auto opponentsColor = color == WHITE ? BLACK : WHITE;
+  return isSquareAttacked(king.getRow(), king.getCol(), opponentsColor);
 }
 
 void Board::moveCastledRook(int endRow, int startCol, int endCol,
@@ -627,8 +544,8 @@ void Board::moveCastledRook(int endRow, int startCol, int endCol,
 
     auto movedRook = squares[endRow][rookStartCol].getPiece();
     movedRook.moved();
-    squares[endRow][rookEndCol].replacePiece(movedRook);
-    squares[endRow][rookStartCol].replacePiece(Piece());
+    replacePiece(endRow, rookEndCol, movedRook);
+    replacePiece(endRow, rookStartCol, Piece());
   }
 }
 
@@ -640,7 +557,7 @@ bool Board::moveEnPassant(int startCol, int endCol,
 
   if (isEnPassant) {
     const auto lastMove = history.back();
-    squares[lastMove.endRow][lastMove.endCol].replacePiece(Piece());
+    replacePiece(lastMove.endRow, lastMove.endCol, Piece());
   }
   return isEnPassant;
 }
@@ -662,11 +579,48 @@ GameInfo Board::makeAMove(int startR, int startC, int endR, int endC) {
 
   movePiece(startRow, startCol, endRow, endCol);
   changeTurn();
+  recordPosition();
   gameStatus = calcGameStatus();
   lastMove = findLastMove();
   return GameInfo(gameStatus, squares, lastMove);
 }
 
+// The search path: the move must come from the legal move list, so it is not
+// verified again, and no game status is calculated. The search finds mates
+// and stalemates from its own move lists, see hasLegalMove and isInCheck.
+void Board::makeSearchMove(const Move &move) {
+  currentSquare = squares[move.startRow][move.startCol];
+  movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
+  changeTurn();
+  recordPosition();
+}
+
+// Stops at the first legal move instead of building every legal move list.
+bool Board::hasLegalMove() {
+  auto ownPieces = bitboards.colors[colorToIndex(turn)];
+  while (ownPieces) {
+    const auto square = bitboard::popLowestSquare(ownPieces);
+    if (canMove(squares[square / BOARD_LENGTH][square % BOARD_LENGTH])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Board::isInCheck() const { return isKingInCheck(turn); }
+
+// Expects a pseudo legal move and only checks that it does not leave the
+// mover's king attacked.
+bool Board::isMoveLegal(const Move &move) const {
+  const auto &takeOffSquare = squares[move.startRow][move.startCol];
+  return !isMoveIllegal(findKing(turn), takeOffSquare,
+                        squares[move.endRow][move.endCol]);
+}
+
+bool Board::isDrawByRepetition() const { return calcThreeFoldRepetition(); }
+
+std::uint64_t Board::getHash() const { return hash; }
+
 void Board::setPromotionType(std::string type) { promotionType = type; }
 
 std::vector<Square> Board::calcAndGetLegalMoves(int r, int c) {
@@ -684,7 +638,7 @@ std::vector<Square> Board::calcAndGetLegalMoves(int r, int c) {
     return legalMoves;
   }
 
-  auto possibleMoves = findPossibleMoves(currentSquare, false);
+  auto possibleMoves = findPossibleMoves(currentSquare);
   legalMoves = findLegalMoves(possibleMoves, turn, currentSquare);
   return legalMoves;
 }
@@ -706,4 +660,282 @@ Move Board::findLastMove() {
   } else {
     return Move(-1, -1, -1, -1);
   }
-}
\ No newline at end of file
+}
+
+// Moves since the last pawn move or capture.
+int Board::calcHalfmoveClock() const {
+  auto pawnMoveOrCapture = [](const Move &m) {
+    return m.pieceTypeMoved == PAWN || m.pieceTypeCaptured != "";
+  };
+  const auto progress =
+      std::find_if(history.rbegin(), history.rend(), pawnMoveOrCapture);
+  if (progress == history.rend()) {
+    return startHalfmoveClock + static_cast<int>(history.size());
+  }
+  return progress - history.rbegin();
+}
+
+// Castling rights are kept as the moved flags of the kings and rooks, and an
+// en passant square as the double step that allows it, put in the history.
+std::shared_ptr<Board> Board::fromFEN(std::string_view fen) {
+  FenPosition position;
+  if (!parseFen(fen, position)) {
+    return nullptr;
+  }
+
+  auto board = std::make_shared<Board>();
+  constexpr char letters[] = "pnbrqk";
+  const std::string types[PIECE_TYPE_COUNT] = {PAWN, KNIGHT, BISHOP,
+                                               ROOK, QUEEN,  KING};
+  for (int row = 0; row < BOARD_LENGTH; row++) {
+    for (int col = 0; col < BOARD_LENGTH; col++) {
+      const auto letter = position.pieces[row * BOARD_LENGTH + col];
+      board->squares[row][col] = Square(row, col);
+      if (letter == ' ') {
+        continue;
+      }
+      const auto color = letter >= 'a' ? BLACK : WHITE;
+      const auto type = std::string_view(letters).find(std::tolower(letter));
+      auto piece = Piece(types[type], color);
+      const auto colorIndex = colorToIndex(color);
+      const auto homeRow = colorIndex == WHITE_INDEX ? BOARD_LENGTH - 1 : 0;
+      const auto &castling = position.castling[colorIndex];
+      const auto keepsRights =
+          row == homeRow &&
+          ((type == KING_INDEX &&
+            (castling[KING_SIDE] || castling[QUEEN_SIDE])) ||
+           (type == ROOK_INDEX && col == BOARD_LENGTH - 1 &&
+            castling[KING_SIDE]) ||
+           (type == ROOK_INDEX && col == 0 && castling[QUEEN_SIDE]));
+      if ((type == KING_INDEX || type == ROOK_INDEX) && !keepsRights) {
+        piece.moved();
+      }
+      board->squares[row][col] = Square(row, col, piece);
+    }
+  }
+
+  board->turn = position.whiteToMove ? WHITE : BLACK;
+  if (position.enPassantSquare >= 0) {
+    const auto row = position.enPassantSquare / BOARD_LENGTH;
+    const auto col = position.enPassantSquare % BOARD_LENGTH;
+    const auto forward = position.whiteToMove ? 1 : -1;
+    board->history.emplace_back(position.whiteToMove ? BLACK : WHITE,
+                                row - forward, col, row + forward, col, PAWN,
+                                "");
+    board->setupMoveCount = 1;
+  }
+  board->startHalfmoveClock = position.halfmoveClock;
+  board->startPly =
+      (position.fullmoveNumber - 1) * 2 + (position.whiteToMove ? 0 : 1);
+  board->calcPieceBitboards();
+  board->calcHash();
+
+  const auto opponent = position.whiteToMove ? BLACK : WHITE;
+  if (board->isKingInCheck(opponent)) {
+    return nullptr;
+  }
+  board->gameStatus = board->calcGameStatus();
+  return board;
+}
+
+std::string Board::toFEN() const {
+  FenPosition position;
+  constexpr char letters[] = "PNBRQK";
+  for (int row = 0; row < BOARD_LENGTH; row++) {
+    for (int col = 0; col < BOARD_LENGTH; col++) {
+      const auto &piece = squares[row][col].getPiece();
+      auto letter = ' ';
+      if (piece.getType() != "") {
+        letter = letters[pieceTypeToIndex(piece.getType())];
+        if (piece.getColor() == BLACK) {
+          letter = std::tolower(letter);
+        }
+      }
+      position.pieces[row * BOARD_LENGTH + col] = letter;
+    }
+  }
+
+  position.whiteToMove = turn == WHITE;
+  for (const auto &color : {WHITE, BLACK}) {
+    const auto homeRow = color == WHITE ? BOARD_LENGTH - 1 : 0;
+    const auto hasNotMoved = [this, homeRow, &color](int col,
+                                                     const std::string &type) {
+      const auto &piece = squares[homeRow][col].getPiece();
+      return piece.getType() == type && piece.getColor() == color &&
+             !piece.getHasMoved();
+    };
+    auto &castling = position.castling[colorToIndex(color)];
+    castling[KING_SIDE] = hasNotMoved(4, KING) && hasNotMoved(7, ROOK);
+    castling[QUEEN_SIDE] = hasNotMoved(4, KING) && hasNotMoved(0, ROOK);
+  }
+
+  position.enPassantSquare = getEnPassantSquare();
+
+  position.halfmoveClock = calcHalfmoveClock();
+  position.fullmoveNumber =
+      (startPly + static_cast<int>(history.size()) - setupMoveCount) / 2 + 1;
+  return formatFen(position);
+}
+
+int Board::getEnPassantSquare() const {
+  if (history.empty()) {
+    return -1;
+  }
+  const auto &lastMove = history.back();
+  if (lastMove.pieceTypeMoved != PAWN || lastMove.player == turn ||
+      std::abs(lastMove.endRow - lastMove.startRow) != 2) {
+    return -1;
+  }
+  return (lastMove.startRow + lastMove.endRow) / 2 * BOARD_LENGTH +
+         lastMove.endCol;
+}
+
+const PieceBitboards &Board::getPieceBitboards() const { return bitboards; }
+
+void Board::calcPieceBitboards() {
+  bitboards = PieceBitboards();
+  for (int i = 0; i < BOARD_LENGTH; i++) {
+    for (int j = 0; j < BOARD_LENGTH; j++) {
+      const auto &piece = squares[i][j].getPiece();
+      if (piece.getType() != "") {
+        bitboards.addPiece(colorToIndex(piece.getColor()),
+                           pieceTypeToIndex(piece.getType()),
+                           toSquareIndex(i, j));
+      }
+    }
+  }
+}
+
+// Every change to squares goes through here so the bitboards stay in sync.
+void Board::replacePiece(int row, int col, const Piece &piece) {
+  const auto square = toSquareIndex(row, col);
+  const auto &oldPiece = squares[row][col].getPiece();
+  if (oldPiece.getType() != "") {
+    const auto color = colorToIndex(oldPiece.getColor());
+    const auto type = pieceTypeToIndex(oldPiece.getType());
+    bitboards.removePiece(color, type, square);
+    hash ^= zobrist::pieceKey(color, type, square);
+  }
+  if (piece.getType() != "") {
+    const auto color = colorToIndex(piece.getColor());
+    const auto type = pieceTypeToIndex(piece.getType());
+    bitboards.addPiece(color, type, square);
+    hash ^= zobrist::pieceKey(color, type, square);
+  }
+  squares[row][col].replacePiece(piece);
+}
+
+void Board::calcHash() {
+  hash = turn == BLACK ? zobrist::sideKey() : 0;
+  for (int color = 0; color < COLOR_COUNT; color++) {
+    for (int type = 0; type < PIECE_TYPE_COUNT; type++) {
+      auto pieces = bitboards.pieces[color][type];
+      while (pieces) {
+        hash ^= zobrist::pieceKey(color, type, bitboard::popLowestSquare(pieces));
+      }
+    }
+  }
+}
+
+bool Board::isCapture(const Move &move) const {
+  const auto &movedPiece = squares[move.startRow][move.startCol].getPiece();
+  const auto &targetPiece = squares[move.endRow][move.endCol].getPiece();
+  const auto isEnPassant =
+      movedPiece.getType() == PAWN && move.startCol != move.endCol;
+  return targetPiece.getType() != "" || isEnPassant;
+}
+
+// Both colors' pieces that attack square, looking outward from the square.
+// Sliders are found through the occupancy that is passed in, so removing a
+// piece from it uncovers any x-ray attacker behind it.
+Bitboard Board::attackersTo(int square, Bitboard occupied,
+                            const PieceBitboards &bitboards) const {
+  const auto &white = bitboards.pieces[WHITE_INDEX];
+  const auto &black = bitboards.pieces[BLACK_INDEX];
+
+  const auto diagonalSliders = white[BISHOP_INDEX] | white[QUEEN_INDEX] |
+                               black[BISHOP_INDEX] | black[QUEEN_INDEX];
+  const auto straightSliders = white[ROOK_INDEX] | white[QUEEN_INDEX] |
+                               black[ROOK_INDEX] | black[QUEEN_INDEX];
+
+  const auto attackers =
+      (bitboard::pawnAttacks(BLACK_INDEX, square) & white[PAWN_INDEX]) |
+      (bitboard::pawnAttacks(WHITE_INDEX, square) & black[PAWN_INDEX]) |
+      (bitboard::knightAttacks(square) &
+       (white[KNIGHT_INDEX] | black[KNIGHT_INDEX])) |
+      (bitboard::kingAttacks(square) &
+       (white[KING_INDEX] | black[KING_INDEX])) |
+      (bitboard::bishopAttacks(square, occupied) & diagonalSliders) |
+      (bitboard::rookAttacks(square, occupied) & straightSliders);
+
+  return attackers & occupied;
+}
+
+// Static exchange evaluation: the material balance for the moving side if
+// both sides keep recapturing on the target square with their least valuable
+// attacker, and either side may stop when continuing would lose material.
+int Board::see(const Move &move) const {
+  constexpr int MAX_EXCHANGES = 32;
+  int gain[MAX_EXCHANGES];
+  int exchange = 0;
+
+  const auto from = toSquareIndex(move.startRow, move.startCol);
+  const auto to = toSquareIndex(move.endRow, move.endCol);
+  const auto &movedPiece = squares[move.startRow][move.startCol].getPiece();
+  const auto &targetPiece = squares[move.endRow][move.endCol].getPiece();
+
+  auto side = colorToIndex(movedPiece.getColor());
+  auto attackerType = pieceTypeToIndex(movedPiece.getType());
+  auto occupied = bitboards.occupied();
+  auto fromBit = bitboard::squareBit(from);
+
+  if (targetPiece.getType() != "") {
+    gain[0] = targetPiece.getValue();
+  } else if (attackerType == PAWN_INDEX && move.startCol != move.endCol) {
+    gain[0] = PIECE_VALUES[PAWN_INDEX];
+    occupied &= ~bitboard::squareBit(
+        toSquareIndex(move.startRow, move.endCol));
+  } else {
+    gain[0] = 0;
+  }
+
+  auto attackers = attackersTo(to, occupied, bitboards);
+
+  while (fromBit && exchange < MAX_EXCHANGES - 1) {
+    exchange++;
+    gain[exchange] = PIECE_VALUES[attackerType] - gain[exchange - 1];
+    if (std::max(-gain[exchange - 1], gain[exchange]) < 0) {
+      break;
+    }
+
+    occupied ^= fromBit;
+    attackers = attackersTo(to, occupied, bitboards);
+    side = side == WHITE_INDEX ? BLACK_INDEX : WHITE_INDEX;
+
+    fromBit = 0;
+    for (int type = PAWN_INDEX; type <= KING_INDEX; type++) {
+      const auto candidates = attackers & bitboards.pieces[side][type];
+      if (candidates) {
+        fromBit = bitboard::squareBit(bitboard::lowestSquare(candidates));
+        attackerType = type;
+        break;
+      }
+    }
+  }
+
+  while (--exchange > 0) {
+    gain[exchange - 1] = -std::max(-gain[exchange - 1], gain[exchange]);
+  }
+  return gain[0];
+}
+
+Bitboard Board::attackersTo(int row, int col) const {
+  return attackersTo(toSquareIndex(row, col), bitboards.occupied(), bitboards);
+}
+
+bool Board::isSquareAttacked(int row, int col,
+                             const std::string &byColor) const {
+  const auto attackers = attackersTo(toSquareIndex(row, col),
+                                     bitboards.occupied(), bitboards);
+  return (attackers & bitboards.colors[colorToIndex(byColor)]) != 0;
+}
@@ -1,9 +1,11 @@
 #ifndef BOARD_H
 #define BOARD_H
+#include "bitboard.h"
+#include "fen.h"
 #include "helpers.h"
 #include "move.h"
 #include "square.h"
-#include <functional>
+#include "zobrist.h"
 #include <map>
 #include <memory>
 #include <string>
@@ -34,25 +36,37 @@ private:
   std::vector<Move> history;
   std::string promotionType;
   std::string gameStatus;
-  std::map<std::string, int> positions;
+  std::vector<std::uint64_t> positionHashes;
+  PieceBitboards bitboards;
+  std::uint64_t hash = 0;
+  // Set up from a FEN: the clocks at the start and the number of moves put in
+  // the history to make en passant possible.
+  int startHalfmoveClock = 0;
+  int startPly = 0;
+  int setupMoveCount = 0;
 
   void changeTurn();
 
-  std::vector<Square> findPossibleMoves(const Square &takeOffSquare,
-                                        bool controllMode);
+  void calcPieceBitboards();
+
+  void calcHash();
+
+  void replacePiece(int row, int col, const Piece &piece);
+
+  std::vector<Square> findPossibleMoves(const Square &takeOffSquare);
 
   void findPossiblePawnMoves(std::vector<Square> &tempPossibleSquares,
-                             const Square &takeOffSquare, bool controllMode);
+                             const Square &takeOffSquare);
 
   void addEnPassant(std::vector<Square> &tempPossibleSquares,
                     const Square &takeOffSquare);
 
   void addPawnStep(std::vector<Square> &tempPossibleSquares,
-                   Square takeOffSquare, bool controllMode);
+                   Square takeOffSquare);
 
   void addPawnCapture(int row, int col,
                       std::vector<Square> &tempPossibleSquares,
-                      const Square &takeOffSquare, const bool &controllMode);
+                      const Square &takeOffSquare);
 
   void findPossibleLinearMoves(const std::vector<Movement> &movements,
                                std::vector<Square> &tempPossibleSquares,
@@ -62,36 +76,32 @@ private:
                                const Square &takeOffSquare);
 
   void findPossibleKingMoves(std::vector<Square> &tempPossibleSquares,
-                             const Square &takeOffSquare, bool controllMode);
+                             const Square &takeOffSquare);
 
   void addKingMoves(std::vector<Square> &tempPossibleSquares,
-                    const std::vector<Square> &controlledSquares,
+                    const std::string &opponentsColor,
                     const Square &takeOffSquare);
 
   void addShortCastle(std::vector<Square> &tempPossibleSquares,
-                      const std::vector<Square> &controlledSquares,
+                      const std::string &opponentsColor,
                       const Square &takeOffSquare);
 
   void addLongCastle(std::vector<Square> &tempPossibleSquares,
-                     const std::vector<Square> &controlledSquares,
+                     const std::string &opponentsColor,
                      const Square &takeOffSquare);
 
   bool addPossibleMove(int currentRow, int currentCol,
                        std::vector<Square> &tempPossibleSquares,
                        const Square &takeOffSquare);
 
-  Square findKing(std::string color);
+  Square findKing(const std::string &color) const;
 
   std::vector<Square> findLegalMoves(const std::vector<Square> &possibleMoves,
                                      std::string kingColor,
                                      Square takoffSquare);
 
-  bool isMoveIllegal(Square kingSquare, Square currentSquare,
-                     Square possibleMove,
-                     const std::vector<Square> &possibleMoves);
-
-  std::vector<Square> findControlledSquares(std::string color,
-                                            bool controllMode);
+  bool isMoveIllegal(const Square &kingSquare, const Square &takeOffSquare,
+                     const Square &possibleMove) const;
 
   bool moveEnPassant(int startCol, int endCol,
                      std::string pieceTypeOnLandingSquare);
@@ -107,15 +117,21 @@ private:
 
   bool canMove(const Square &square);
 
-  bool isKingInCheck(const Square &square, std::string opponentsColor,
-                     std::function<bool(Square s)> searchForKing);
+  bool isKingInCheck(const std::string &color) const;
+
+  int calcMatingMaterial(const std::string &color) const;
 
-  int calcMatingMaterial(const Piece &piece, const std::string &color);
+  bool calcThreeFoldRepetition() const;
 
-  bool calcThreeFoldRepetition();
+  void recordPosition();
 
   Move findLastMove();
 
+  int calcHalfmoveClock() const;
+
+  Bitboard attackersTo(int square, Bitboard occupied,
+                       const PieceBitboards &bitboards) const;
+
 public:
   Board();
 
@@ -124,12 +140,33 @@ public:
   Board(Squares squares, std::vector<Square> possibleSquares, std::string turn,
         Square currentSquare, std::vector<Move> history);
 
+  // nullptr when fen is not a valid position, see parseFen, or when the side
+  // that is not to move is in check.
+  static std::shared_ptr<Board> fromFEN(std::string_view fen);
+
+  std::string toFEN() const;
+
+  // The square behind a pawn that just made a double step, where it may be
+  // captured en passant, or -1.
+  int getEnPassantSquare() const;
+
   GameInfo makeAMove(int startR, int startC, int endR, int endC);
+  void makeSearchMove(const Move &move);
+  bool hasLegalMove();
+  bool isInCheck() const;
+  bool isMoveLegal(const Move &move) const;
+  bool isDrawByRepetition() const;
+  std::uint64_t getHash() const;
   void setPromotionType(std::string type);
   std::vector<Square> calcAndGetLegalMoves(int row, int col);
   Squares getSquares() const;
   Square getSquare(int row, int col) const;
   std::string getTurn();
   GameInfo getGameInfo();
+  const PieceBitboards &getPieceBitboards() const;
+  bool isCapture(const Move &move) const;
+  int see(const Move &move) const;
+  Bitboard attackersTo(int row, int col) const;
+  bool isSquareAttacked(int row, int col, const std::string &byColor) const;
 };
 #endif // BOARD_H
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "bookFile.h"
+#include "constants.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(BookEntry) == 24, "book entries are 24 bytes");
+static_assert(sizeof(BookHeader) == 16, "the book header is 16 bytes");
+
+static bool compareKeys(const BookEntry &a, const BookEntry &b) {
+  return a.key < b.key;
+}
+
+Move BookEntry::getMove() const {
+  const int from = move % SQUARE_COUNT;
+  const int to = move / SQUARE_COUNT % SQUARE_COUNT;
+  return Move(from / BOARD_LENGTH, from % BOARD_LENGTH, to / BOARD_LENGTH,
+              to % BOARD_LENGTH);
+}
+
+std::uint16_t BookEntry::encodeMove(const Move &move) {
+  const int from = move.startRow * BOARD_LENGTH + move.startCol;
+  const int to = move.endRow * BOARD_LENGTH + move.endCol;
+  return from + to * SQUARE_COUNT;
+}
+
+BookFile::~BookFile() { close(); }
+
+bool BookFile::open(const std::string &path) {
+  close();
+
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 ||
+      fileStat.st_size < static_cast<off_t>(sizeof(BookHeader))) {
+    ::close(fd);
+    return false;
+  }
+
+  const auto size = static_cast<std::size_t>(fileStat.st_size);
+  auto *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  const auto *header = static_cast<const BookHeader *>(data);
+  const BookHeader expected;
+  if (std::memcmp(header->magic, expected.magic, sizeof(expected.magic)) != 0 ||
+      header->version != expected.version ||
+      header->count > (size - sizeof(BookHeader)) / sizeof(BookEntry)) {
+    munmap(data, size);
+    return false;
+  }
+
+  mapping = data;
+  mappingSize = size;
+  entries = reinterpret_cast<const BookEntry *>(header + 1);
+  count = header->count;
+  return true;
+}
+
+void BookFile::close() {
+  if (mapping != nullptr) {
+    munmap(mapping, mappingSize);
+  }
+  mapping = nullptr;
+  mappingSize = 0;
+  entries = nullptr;
+  count = 0;
+}
+
+bool BookFile::isOpen() const { return mapping != nullptr; }
+
+std::size_t BookFile::size() const { return count; }
+
+std::vector<BookEntry> BookFile::probe(std::uint64_t key) const {
+  BookEntry wanted;
+  wanted.key = key;
+  const auto range =
+      std::equal_range(entries, entries + count, wanted, compareKeys);
+  return std::vector<BookEntry>(range.first, range.second);
+}
+
+bool BookFile::write(const std::string &path, std::vector<BookEntry> entries) {
+  std::stable_sort(begin(entries), end(entries), compareKeys);
+
+  BookHeader header;
+  header.count = entries.size();
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(entries.data()),
+             entries.size() * sizeof(BookEntry));
+  return static_cast<bool>(file);
+}
@@ -0,0 +1,65 @@
+#ifndef BOOK_FILE_H
+#define BOOK_FILE_H
+#include "move.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One book move. The layout starts like a Polyglot entry, but the key is
+// Board::getHash and the move is from + to * 64 with squares numbered
+// row * 8 + col. The computer always promotes to a queen, so no promotion is
+// stored. The weight decides how often the move is picked; wins, draws and
+// losses count the games it was played in, from the mover's point of view.
+struct BookEntry {
+  std::uint64_t key = 0;
+  std::uint16_t move = 0;
+  std::uint16_t weight = 0;
+  std::uint32_t wins = 0;
+  std::uint32_t draws = 0;
+  std::uint32_t losses = 0;
+
+  Move getMove() const;
+
+  static std::uint16_t encodeMove(const Move &move);
+};
+
+// Precedes the entries in a book file.
+struct BookHeader {
+  char magic[4] = {'C', 'B', 'O', 'K'};
+  std::uint32_t version = 3;
+  std::uint64_t count = 0;
+};
+
+// A binary opening book, entries sorted by key. The file is memory mapped and
+// searched where it lies, so opening a book costs the same whatever its size
+// and only the pages that are looked at are read.
+class BookFile {
+private:
+  const BookEntry *entries = nullptr;
+  std::size_t count = 0;
+  void *mapping = nullptr;
+  std::size_t mappingSize = 0;
+
+public:
+  BookFile() = default;
+  ~BookFile();
+  BookFile(const BookFile &) = delete;
+  BookFile &operator=(const BookFile &) = delete;
+
+  // Returns false, and leaves the book closed, when path is not a book file.
+  bool open(const std::string &path);
+
+  void close();
+
+  bool isOpen() const;
+
+  std::size_t size() const;
+
+  // The moves for a position, empty when the book does not know it.
+  std::vector<BookEntry> probe(std::uint64_t key) const;
+
+  // Sorts the entries and writes them as a book file.
+  static bool write(const std::string &path, std::vector<BookEntry> entries);
+};
+
+#endif // BOOK_FILE_H
@@ -3,31 +3,212 @@
 
 Computer::Computer(std::shared_ptr<Board> board, std::string color,
                    std::chrono::milliseconds timePerMove)
-    : board(board), color(color), timePerMove(timePerMove) {}
+    : board(board), color(color), timePerMove(timePerMove),
+      timeManager(timePerMove / 2, timePerMove) {}
 
-Move Computer::findMove() {
+void Computer::stop() { control->stopRequested.store(true); }
 
-  if (board->getTurn() != color) {
+void Computer::resetStop() { control->stopRequested.store(false); }
+
+SearchProgress Computer::getProgress() const {
+  std::lock_guard<std::mutex> lock(control->mutex);
+  return control->progress;
+}
+
+void Computer::setBoard(std::shared_ptr<Board> board) { this->board = board; }
+
+void Computer::setPondering(bool pondering) {
+  control->pondering.store(pondering);
+}
+
+Move Computer::getTableMove(std::shared_ptr<Board> position) {
+  if (!table) {
+    return Move(0, 0, 0, 0);
+  }
+  const auto entry = table->probe(position->getHash());
+  if (!entry) {
+    return Move(0, 0, 0, 0);
+  }
+  const auto moves = findAllMoves(std::make_shared<Board>(position));
+  const auto move = entry->getMove();
+  if (std::find(std::begin(moves), std::end(moves), move) == std::end(moves)) {
     return Move(0, 0, 0, 0);
   }
+  return move;
+}
 
-  board->setPromotionType(QUEEN);
-  if (timePerMove == std::chrono::milliseconds(0)) {
-    return getRandomMove();
+SearchStats Computer::getStats() const {
+  std::lock_guard<std::mutex> lock(control->mutex);
+  return control->stats;
+}
+
+void Computer::setIterationCallback(IterationCallback callback) {
+  iterationCallback = callback;
+}
+
+// Fills in the totals and rates from the counters and publishes the stats.
+void Computer::updateStats() {
+  stats.nodes = nodes;
+  stats.milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - searchStartTime)
+                           .count();
+  stats.nodesPerSecond =
+      stats.milliseconds > 0 ? nodes * 1000 / stats.milliseconds : 0;
+  stats.tableHitRate = stats.tableProbes > 0
+                           ? double(stats.tableHits) / stats.tableProbes
+                           : 0;
+  stats.firstMoveCutoffRate =
+      stats.cutoffs > 0 ? double(stats.firstMoveCutoffs) / stats.cutoffs : 0;
+
+  const auto &iterations = stats.iterations;
+  const auto count = iterations.size();
+  if (count >= 2 && iterations[count - 2].nodes > 0) {
+    stats.effectiveBranchingFactor =
+        double(iterations[count - 1].nodes) / iterations[count - 2].nodes;
+  }
+
+  std::lock_guard<std::mutex> lock(control->mutex);
+  control->stats = stats;
+}
+
+void Computer::setStrengthLevel(int level) {
+  useFixedLimits = level > 0;
+  limits = getStrengthLevel(level);
+}
+
+void Computer::setSearchLimits(int maxDepth, long nodeLimit) {
+  useFixedLimits = true;
+  limits.maxDepth = std::min(maxDepth, MAX_DEPTH);
+  limits.nodeLimit = nodeLimit;
+  limits.randomMargin = 0;
+}
+
+void Computer::setSeed(unsigned int seed) { randomizer->setSeed(seed); }
+
+void Computer::setTable(std::shared_ptr<TranspositionTable> table) {
+  this->table = table;
+}
+
+std::shared_ptr<TranspositionTable> Computer::getTable() {
+  if (!table) {
+    table = std::make_shared<TranspositionTable>(tableSize);
+  }
+  return table;
+}
+
+bool Computer::hasTable() const { return table != nullptr; }
+
+void Computer::setTableSize(std::size_t size) {
+  tableSize = size;
+  table = nullptr;
+}
+
+// The node limits give every level roughly four times the work of the one
+// below it. The margins are in evaluation units, where a pawn is 10.
+StrengthLevel Computer::getStrengthLevel(int level) {
+  static const StrengthLevel levels[STRENGTH_LEVEL_COUNT] = {
+      {1, 500, 30},     {2, 2000, 20},     {3, 8000, 12},
+      {4, 25000, 8},    {5, 75000, 4},     {6, 200000, 0},
+      {8, 500000, 0},   {MAX_DEPTH, 1500000, 0}};
+  if (level <= 0) {
+    return StrengthLevel();
+  }
+  return levels[std::min(level, STRENGTH_LEVEL_COUNT) - 1];
+}
+
+void Computer::setMultiPv(int count) { multiPv = std::max(count, 1); }
+
+std::vector<AnalysisLine> Computer::getLines() const {
+  std::lock_guard<std::mutex> lock(control->mutex);
+  return control->lines;
+}
+
+// The root moves of the last completed depth that a level with a random
+// margin may play instead of the best one. The margin also lowers the root's
+// lower bound, so these moves all have exact scores. A mate is never traded
+// for a random move.
+void Computer::collectNearBestMoves() {
+  nearBestMoves.clear();
+  const auto bestScore = rootMoves[0].evaluationScore;
+  if (limits.randomMargin == 0 ||
+      bestScore >= MATE_SCORE - MAX_DEPTH * 2) {
+    return;
+  }
+  for (const auto &evalInfo : rootMoves) {
+    if (evalInfo.evaluationScore >= bestScore - limits.randomMargin) {
+      nearBestMoves.push_back(evalInfo.move);
+    }
   }
+}
+
+void Computer::publishLines() {
+  std::vector<AnalysisLine> lines;
+  const auto count = std::min<std::size_t>(multiPv, rootMoves.size());
+  for (std::size_t i = 0; i < count; i++) {
+    lines.push_back(toAnalysisLine(rootMoves[i]));
+  }
+  std::lock_guard<std::mutex> lock(control->mutex);
+  control->lines = lines;
+}
+
+// The line found by the search stops where the transposition table cut it
+// short, so it is continued with the table's best moves. The evaluation's
+// pawn is worth 10, so centipawns are ten times the score.
+AnalysisLine Computer::toAnalysisLine(const EvalInfo &evalInfo) {
+  AnalysisLine analysisLine;
+  analysisLine.moves = evalInfo.line;
+  analysisLine.depth = rootDepth;
+
+  auto position = std::make_shared<Board>(board);
+  for (const auto &move : analysisLine.moves) {
+    position->makeSearchMove(move);
+  }
+  while (analysisLine.moves.size() < static_cast<std::size_t>(rootDepth) &&
+         !position->isDrawByRepetition()) {
+    const auto move = getTableMove(position);
+    if (move == Move(0, 0, 0, 0)) {
+      break;
+    }
+    position->makeSearchMove(move);
+    analysisLine.moves.push_back(move);
+  }
+
+  const auto score = evalInfo.evaluationScore;
+  const auto sign = color == WHITE ? 1 : -1;
+  if (score >= MATE_SCORE - MAX_DEPTH * 2) {
+    analysisLine.mateIn = sign * ((MATE_SCORE - score + 1) / 2);
+  } else if (score <= -MATE_SCORE + MAX_DEPTH * 2) {
+    analysisLine.mateIn = -sign * ((MATE_SCORE + score + 1) / 2);
+  } else {
+    analysisLine.centipawns = sign * score * 10;
+  }
+  return analysisLine;
+}
+
+void Computer::publishProgress(int depth, const EvalInfo &best) {
+  std::lock_guard<std::mutex> lock(control->mutex);
+  control->progress.depth = depth;
+  control->progress.nodes = nodes;
+  control->progress.score = best.evaluationScore;
+  control->progress.bestMove = best.move;
+}
 
-  return getMaxMinMove();
+Move Computer::findMove() {
+  startSearch();
+  searchUntil(std::chrono::steady_clock::time_point::max());
+  return bestMove;
 }
 
 Move Computer::getRandomMove() {
 
-  srand(time(NULL));
   auto allMovablePieces = findAllMovablePieces(board);
-  auto pieceIndex = rand() % allMovablePieces.size();
+  auto pieceIndex =
+      randomizer->generateRandomNumber(0, allMovablePieces.size() - 1);
 
   for (auto const &pair : allMovablePieces) {
     if (pieceIndex == 0) {
-      auto squareIndex = rand() % pair.second.size();
+      auto squareIndex =
+          randomizer->generateRandomNumber(0, pair.second.size() - 1);
       for (auto const &move : pair.second) {
         if (squareIndex == 0) {
           int row = pair.first[0] - '0';
@@ -42,206 +223,461 @@ Move Computer::getRandomMove() {
   return Move(0, 0, 0, 0);
 }
 
-Move Computer::getMaxMinMove() {
+// Prepares a search of the current position. Nothing is searched until
+// step or findMove runs it. If there is nothing to search, the search is
+// finished at once and getBestMove already holds the answer.
+void Computer::startSearch() {
+
+  frames.clear();
+  rootMoves.clear();
+  nearBestMoves.clear();
+  bestMove = Move(0, 0, 0, 0);
+  searchFinished = false;
+  {
+    std::lock_guard<std::mutex> lock(control->mutex);
+    control->lines.clear();
+  }
+  searchStartTime = std::chrono::steady_clock::now();
+  nodes = 0;
+  stats = SearchStats();
 
-  auto topScores = calcFirstMaxMinBatch();
+  if (board->getTurn() != color) {
+    finishSearch();
+    return;
+  }
 
-  if (topScores.size() == 0) {
-    return Move(0, 0, 0, 0);
+  board->setPromotionType(QUEEN);
+  if (!useFixedLimits && !useClock &&
+      timePerMove == std::chrono::milliseconds(0)) {
+    bestMove = getRandomMove();
+    finishSearch();
+    return;
   }
 
-  if (topScores.size() == 1) {
-    return topScores[0].move;
+  getTable();
+  if (useClock) {
+    timeManager = TimeManager::fromClock(clock);
+  }
+  timeManager.start();
+  searchAborted = false;
+  {
+    std::lock_guard<std::mutex> lock(control->mutex);
+    control->progress = SearchProgress();
   }
 
-  return maxMinSearch(topScores);
+  rootMoves = calcRootMoves();
+  if (rootMoves.size() <= 1) {
+    if (rootMoves.size() == 1) {
+      bestMove = rootMoves[0].move;
+    }
+    finishSearch();
+    return;
+  }
+
+  bestMove = rootMoves[0].move;
+  startIteration(1);
 }
 
-Move Computer::maxMinSearch(std::vector<EvalInfo> topScores) {
-  auto startTime = std::chrono::system_clock::now();
-  auto currentTime = std::chrono::system_clock::now();
-  auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-      currentTime - startTime);
+// Runs the search for about budget and tells whether it has finished. The
+// time between two steps counts against the time for the move, so the move
+// still arrives when the time manager says it should.
+bool Computer::step(std::chrono::microseconds budget) {
+  if (searchFinished) {
+    return true;
+  }
+  return searchUntil(std::chrono::steady_clock::now() + budget);
+}
 
-  std::vector<EvalInfo> nextIteration;
-  while (duration < timePerMove) {
+// The best move of the last completed depth while the search runs, the move
+// to play once it has finished.
+Move Computer::getBestMove() const { return bestMove; }
 
-    for (auto &evalInfo : topScores) {
-      auto iteration = maxMinIteration(evalInfo);
-      nextIteration.insert(std::end(nextIteration), std::begin(iteration),
-                           std::end(iteration));
-    }
-    if (nextIteration.size() == 0) {
-      break;
-    }
+bool Computer::isSearchFinished() const { return searchFinished; }
 
-    topScores.swap(nextIteration);
-    if (topScores.size() >= 27) {
-      std::sort(std::begin(topScores), std::end(topScores));
-      topScores.erase(topScores.begin(), topScores.end() - 3);
+void Computer::finishSearch() {
+  frames.clear();
+  searchFinished = true;
+  if (!nearBestMoves.empty()) {
+    bestMove = nearBestMoves[randomizer->generateRandomNumber(
+        0, nearBestMoves.size() - 1)];
+  }
+  updateStats();
+  resetStop();
+}
+
+// The deadline is only compared every STEP_CHECK_INTERVAL steps of work, each
+// of which searches at most one node.
+bool Computer::searchUntil(std::chrono::steady_clock::time_point deadline) {
+  long work = 0;
+  while (!searchFinished) {
+    advance();
+    if (++work % STEP_CHECK_INTERVAL == 0 &&
+        std::chrono::steady_clock::now() >= deadline) {
+      break;
     }
+  }
+  return searchFinished;
+}
 
-    currentTime = std::chrono::system_clock::now();
-    duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-        currentTime - startTime);
+// Iterative deepening. Every completed depth replaces the best move and
+// reorders the root moves so the next depth starts with the best one.
+void Computer::startIteration(int depth) {
+  const auto onTime =
+      !useFixedLimits && !control->pondering.load(std::memory_order_relaxed);
+  if (depth > limits.maxDepth ||
+      (onTime && !timeManager.canStartIteration())) {
+    finishSearch();
+    return;
   }
-  std::sort(std::begin(topScores), std::end(topScores));
-  return topScores.back().move;
+  rootDepth = depth;
+  rootIndex = 0;
+  rootAlpha = -INFINITE_SCORE;
+  iterationStartNodes = nodes;
+  iterationStartMilliseconds = timeManager.getElapsed().count();
 }
 
-std::vector<EvalInfo> Computer::calcFirstMaxMinBatch() {
-  auto allMovablePieces = findAllMovablePieces(board);
-  std::vector<EvalInfo> topScores;
-  const int SCORE_LIMIT = 3;
+void Computer::completeIteration() {
+  std::stable_sort(std::begin(rootMoves), std::end(rootMoves),
+                   [](const EvalInfo &a, const EvalInfo &b) { return b < a; });
+  auto bestMoveChanged = rootDepth == 1 || !(rootMoves[0].move == bestMove);
+  bestMove = rootMoves[0].move;
+  timeManager.completeIteration(bestMoveChanged, rootMoves[0].evaluationScore);
+  table->store(board->getHash(), rootDepth, rootMoves[0].evaluationScore,
+               Bound::EXACT, bestMove);
+  publishProgress(rootDepth, rootMoves[0]);
+  publishLines();
+  collectNearBestMoves();
+
+  IterationStats iteration;
+  iteration.depth = rootDepth;
+  iteration.nodes = nodes - iterationStartNodes;
+  iteration.milliseconds =
+      timeManager.getElapsed().count() - iterationStartMilliseconds;
+  iteration.score = rootMoves[0].evaluationScore;
+  stats.depth = rootDepth;
+  stats.iterations.push_back(iteration);
+  updateStats();
+  if (iterationCallback) {
+    iterationCallback(stats);
+  }
 
-  for (auto const &pair : allMovablePieces) {
-    for (auto const &move : pair.second) {
-      auto boardAfter1Move = std::make_shared<Board>(board);
+  if (rootMoves[0].evaluationScore >= MATE_SCORE - MAX_DEPTH) {
+    finishSearch();
+    return;
+  }
+  startIteration(rootDepth + 1);
+}
 
-      int row = pair.first[0] - '0';
-      int col = pair.first[1] - '0';
-      boardAfter1Move->calcAndGetLegalMoves(row, col);
+// When the search is aborted, by the hard time limit or by stop(), the root
+// moves that were fully searched at the aborted depth are still used: the
+// first of them is the previous best move, so a different one only wins if
+// it really scored better.
+void Computer::abortIteration() {
+  std::stable_sort(std::begin(rootMoves), std::begin(rootMoves) + rootIndex,
+                   [](const EvalInfo &a, const EvalInfo &b) { return b < a; });
+  if (rootIndex > 0) {
+    bestMove = rootMoves[0].move;
+  }
+  finishSearch();
+}
 
-      auto gameInfo =
-          boardAfter1Move->makeAMove(row, col, move.getRow(), move.getCol());
+void Computer::setClock(const GameClock &clock) {
+  this->clock = clock;
+  useClock = true;
+}
 
-      if (gameInfo.getStatus() == WHITE_WON ||
-          gameInfo.getStatus() == BLACK_WON) {
-        return {EvalInfo(boardAfter1Move,
-                         Move(row, col, move.getRow(), move.getCol()), 1000)};
-      }
+std::vector<EvalInfo> Computer::calcRootMoves() {
+  std::vector<EvalInfo> rootMoves;
+  for (auto const &move : findAllMoves(board)) {
+    auto boardAfterMove = std::make_shared<Board>(board);
+    boardAfterMove->makeSearchMove(move);
+    rootMoves.emplace_back(boardAfterMove, move, -INFINITE_SCORE);
+  }
+  return rootMoves;
+}
 
-      int minScore = 999999;
-      EvalInfo topEvalInfo;
-
-      auto opponentsAllMovablePieces = findAllMovablePieces(boardAfter1Move);
-      for (auto const &opponentsPair : opponentsAllMovablePieces) {
-        for (auto const &opponentsMove : opponentsPair.second) {
-          auto boardAfter2Moves = std::make_shared<Board>(boardAfter1Move);
-          int opponentsRow = opponentsPair.first[0] - '0';
-          int opponentsCol = opponentsPair.first[1] - '0';
-          boardAfter2Moves->calcAndGetLegalMoves(opponentsRow, opponentsCol);
-
-          auto opponentsGameInfo = boardAfter2Moves->makeAMove(
-              opponentsRow, opponentsCol, opponentsMove.getRow(),
-              opponentsMove.getCol());
-
-          int currentEvaluation;
-          if (opponentsGameInfo.getStatus() == WHITE_WON ||
-              opponentsGameInfo.getStatus() == BLACK_WON) {
-            currentEvaluation = -1000;
-          } else {
-            currentEvaluation = calcEvaluation(boardAfter2Moves);
-          }
-          if (minScore > currentEvaluation) {
-            minScore = currentEvaluation;
-            topEvalInfo = EvalInfo(boardAfter2Moves,
-                                   Move(row, col, move.getRow(), move.getCol()),
-                                   currentEvaluation);
-          }
-        }
-      }
-      if (topScores.size() <= SCORE_LIMIT) {
-        topScores.emplace_back(topEvalInfo);
-      } else {
-        topScores[0] = topEvalInfo;
-      }
+// The root moves are scored in order, each one with a full window above and
+// the lower bound set by the moves already searched: the best score so far,
+// or with multi PV the multiPv-th best, so that the best multiPv moves all
+// get exact scores. A strength level's random margin lowers it further.
+void Computer::completeRootMove(int score, const std::vector<Move> &line) {
+  auto &evalInfo = rootMoves[rootIndex];
+  evalInfo.evaluationScore = score;
+  evalInfo.line = {evalInfo.move};
+  evalInfo.line.insert(std::end(evalInfo.line), std::begin(line),
+                       std::end(line));
+  rootIndex++;
+
+  if (static_cast<int>(rootIndex) < multiPv) {
+    return;
+  }
+  std::vector<int> scores;
+  for (std::size_t i = 0; i < rootIndex; i++) {
+    scores.push_back(rootMoves[i].evaluationScore);
+  }
+  std::nth_element(std::begin(scores), std::begin(scores) + multiPv - 1,
+                   std::end(scores), std::greater<int>());
+  rootAlpha = scores[multiPv - 1] - limits.randomMargin;
+}
 
-      std::sort(std::begin(topScores), std::end(topScores));
+// Does one step of the search: starts the next root move, enters a node, or
+// makes the next move of the node on top of the stack. The stack replaces
+// the recursion of a plain alpha beta search so the search can be paused
+// after any step and continued later.
+void Computer::advance() {
+
+  if (frames.empty()) {
+    if (rootIndex == rootMoves.size()) {
+      completeIteration();
+      return;
+    }
+    const auto &evalInfo = rootMoves[rootIndex];
+    if (evalInfo.board->isDrawByRepetition()) {
+      completeRootMove(0, {});
+      return;
     }
+    pushFrame(evalInfo.board, rootDepth - 1, -INFINITE_SCORE, -rootAlpha, 1,
+              false);
+    return;
+  }
+
+  auto &frame = frames.back();
+  if (!frame.entered) {
+    enterFrame(frame);
+    return;
+  }
+
+  if (frame.nextMove == frame.moves.size()) {
+    returnScore(frame.quiescence ? frame.alpha : frame.bestScore);
+    return;
   }
 
-  if (topScores.size() > SCORE_LIMIT) {
-    topScores.erase(topScores.begin());
+  const auto move = frame.moves[frame.nextMove++];
+  if (frame.quiescence && !frame.board->isMoveLegal(move)) {
+    return;
   }
-  return topScores;
+
+  auto nextBoard = std::make_shared<Board>(frame.board);
+  nextBoard->makeSearchMove(move);
+  if (!frame.quiescence && nextBoard->isDrawByRepetition()) {
+    applyScore(0);
+    return;
+  }
+  pushFrame(nextBoard, frame.depth - 1, -frame.beta, -frame.alpha,
+            frame.ply + 1, frame.quiescence);
 }
 
-std::vector<EvalInfo> Computer::maxMinIteration(EvalInfo &evalInfo) {
-  auto allMovablePieces = findAllMovablePieces(evalInfo.board);
-  std::vector<EvalInfo> topScores;
-  const int SCORE_LIMIT = 3;
+// Below depth zero only captures are searched, and only those that do not
+// lose material according to the static exchange evaluation.
+void Computer::pushFrame(std::shared_ptr<Board> board, int depth, int alpha,
+                         int beta, int ply, bool quiescence) {
+  SearchFrame frame;
+  frame.board = board;
+  frame.quiescence = quiescence || depth <= 0;
+  frame.depth = depth;
+  frame.alpha = alpha;
+  frame.beta = beta;
+  frame.ply = ply;
+  frame.originalAlpha = alpha;
+  frames.push_back(std::move(frame));
+}
 
-  for (auto const &pair : allMovablePieces) {
-    for (auto const &move : pair.second) {
-      auto boardAfter1Move = std::make_shared<Board>(evalInfo.board);
+// In quiescence the side to move may always stop capturing and take the
+// static evaluation instead.
+void Computer::enterFrame(SearchFrame &frame) {
 
-      int row = pair.first[0] - '0';
-      int col = pair.first[1] - '0';
-      boardAfter1Move->calcAndGetLegalMoves(row, col);
+  frame.entered = true;
+  if (!countNode()) {
+    abortIteration();
+    return;
+  }
 
-      auto gameInfo =
-          boardAfter1Move->makeAMove(row, col, move.getRow(), move.getCol());
+  if (frame.quiescence) {
+    if (frame.board->isInCheck() && !frame.board->hasLegalMove()) {
+      returnScore(-MATE_SCORE + frame.ply);
+      return;
+    }
 
-      if (gameInfo.getStatus() == WHITE_WON ||
-          gameInfo.getStatus() == BLACK_WON) {
-        topScores.emplace_back(boardAfter1Move, evalInfo.move, 1000);
-        return topScores;
-      }
+    const auto standPat = calcEvaluation(frame.board);
+    if (standPat >= frame.beta) {
+      returnScore(standPat);
+      return;
+    }
+    frame.alpha = std::max(frame.alpha, standPat);
+    frame.moves = findGoodCaptures(frame.board);
+    return;
+  }
 
-      int minScore = 999999;
-      EvalInfo topEvalInfo;
-
-      auto opponentsAllMovablePieces = findAllMovablePieces(boardAfter1Move);
-      for (auto const &opponentsPair : opponentsAllMovablePieces) {
-        for (auto const &opponentsMove : opponentsPair.second) {
-          auto boardAfter2Moves = std::make_shared<Board>(boardAfter1Move);
-          int opponentsRow = opponentsPair.first[0] - '0';
-          int opponentsCol = opponentsPair.first[1] - '0';
-          boardAfter2Moves->calcAndGetLegalMoves(opponentsRow, opponentsCol);
-
-          auto opponentsGameInfo = boardAfter2Moves->makeAMove(
-              opponentsRow, opponentsCol, opponentsMove.getRow(),
-              opponentsMove.getCol());
-
-          int currentEvaluation;
-          if (opponentsGameInfo.getStatus() == WHITE_WON ||
-              opponentsGameInfo.getStatus() == BLACK_WON) {
-            currentEvaluation = -1000;
-          } else {
-            currentEvaluation = calcEvaluation(boardAfter2Moves);
-          }
-          if (minScore > currentEvaluation) {
-            minScore = currentEvaluation;
-            topEvalInfo =
-                EvalInfo(boardAfter2Moves, evalInfo.move, currentEvaluation);
-          }
-        }
-      }
-      if (topScores.size() <= SCORE_LIMIT) {
-        topScores.emplace_back(topEvalInfo);
-      } else {
-        topScores[0] = topEvalInfo;
-      }
+  if (probeTable(frame)) {
+    return;
+  }
+  if (frame.moves.empty()) {
+    returnScore(frame.board->isInCheck() ? -MATE_SCORE + frame.ply : 0);
+  }
+}
+
+// Returns true if the table already knows enough about the position to
+// return its score. Otherwise generates the moves, with the table's best
+// move first.
+bool Computer::probeTable(SearchFrame &frame) {
+
+  const auto entry = table->probe(frame.board->getHash());
+  stats.tableProbes++;
+  if (entry) {
+    stats.tableHits++;
+  }
+  if (entry && entry->depth >= frame.depth) {
+    const auto score = scoreFromTable(entry->score, frame.ply);
+    if (entry->bound == Bound::EXACT ||
+        (entry->bound == Bound::LOWER && score >= frame.beta) ||
+        (entry->bound == Bound::UPPER && score <= frame.alpha)) {
+      returnScore(score);
+      return true;
+    }
+  }
 
-      std::sort(std::begin(topScores), std::end(topScores));
+  frame.moves = findAllMoves(frame.board);
+  if (entry) {
+    auto tableMove = std::find(std::begin(frame.moves), std::end(frame.moves),
+                               entry->getMove());
+    if (tableMove != std::end(frame.moves)) {
+      std::rotate(std::begin(frame.moves), tableMove, tableMove + 1);
     }
   }
+  return false;
+}
 
-  if (topScores.size() > SCORE_LIMIT) {
-    topScores.erase(topScores.begin());
+void Computer::storeFrame(const SearchFrame &frame, int score) {
+  auto bound = Bound::EXACT;
+  if (score >= frame.beta) {
+    bound = Bound::LOWER;
+  } else if (score <= frame.originalAlpha) {
+    bound = Bound::UPPER;
   }
+  table->store(frame.board->getHash(), frame.depth,
+               scoreToTable(score, frame.ply), bound, frame.bestMove);
+}
 
-  return topScores;
+// Mate scores count plies from the root. The table stores them counted from
+// the position itself, so they stay right when it is reached at another ply.
+int Computer::scoreToTable(int score, int ply) {
+  if (score >= MATE_SCORE - MAX_DEPTH * 2) {
+    return score + ply;
+  }
+  if (score <= -MATE_SCORE + MAX_DEPTH * 2) {
+    return score - ply;
+  }
+  return score;
+}
+
+int Computer::scoreFromTable(int score, int ply) {
+  if (score >= MATE_SCORE - MAX_DEPTH * 2) {
+    return score - ply;
+  }
+  if (score <= -MATE_SCORE + MAX_DEPTH * 2) {
+    return score + ply;
+  }
+  return score;
+}
+
+// Pops the node on top of the stack and hands its score to its parent. Nodes
+// that searched their moves are remembered in the transposition table.
+void Computer::returnScore(int score) {
+  const auto &frame = frames.back();
+  if (!frame.quiescence && !frame.moves.empty()) {
+    storeFrame(frame, score);
+  }
+  const auto line = std::move(frames.back().line);
+  frames.pop_back();
+  if (frames.empty()) {
+    completeRootMove(-score, line);
+    return;
+  }
+  applyScore(-score, line);
+}
+
+// A child of the node on top of the stack was searched. Fail soft: a cutoff
+// returns the score that caused it.
+void Computer::applyScore(int score, const std::vector<Move> &line) {
+  auto &frame = frames.back();
+  const auto &move = frame.moves[frame.nextMove - 1];
+  if (score > frame.bestScore) {
+    frame.bestScore = score;
+    frame.bestMove = move;
+  }
+  if (score > frame.alpha && score < frame.beta) {
+    frame.line = {move};
+    frame.line.insert(std::end(frame.line), std::begin(line), std::end(line));
+  }
+  if (score >= frame.beta) {
+    if (!frame.quiescence) {
+      stats.cutoffs++;
+      if (frame.nextMove == 1) {
+        stats.firstMoveCutoffs++;
+      }
+    }
+    returnScore(score);
+    return;
+  }
+  frame.alpha = std::max(frame.alpha, score);
+}
+
+// Counts a searched node and tells whether the search may go on.
+bool Computer::countNode() {
+  nodes++;
+  const auto onTime =
+      !useFixedLimits && !control->pondering.load(std::memory_order_relaxed);
+  searchAborted = searchAborted ||
+                  control->stopRequested.load(std::memory_order_relaxed) ||
+                  (limits.nodeLimit > 0 &&
+                   nodes >= limits.nodeLimit) ||
+                  (onTime && timeManager.shouldAbort(nodes));
+  if (nodes % TimeManager::CHECK_INTERVAL == 0) {
+    std::lock_guard<std::mutex> lock(control->mutex);
+    control->progress.nodes = nodes;
+  }
+  return !searchAborted;
 }
 
 int Computer::calcEvaluation(std::shared_ptr<Board> currentBoard) {
 
+  const auto &pieces = currentBoard->getPieceBitboards().pieces;
+  const auto &values = getPieceSquareValues();
+  const auto ownColor = colorToIndex(currentBoard->getTurn());
   int evaluationScore = 0;
 
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      const auto &piece = currentBoard->getSquare(i, j).getPiece();
-      if (piece.getColor() == currentBoard->getTurn()) {
-        evaluationScore += getCurrentPieceValue(piece, i, j);
-      } else if (piece.getColor() != "") {
-        evaluationScore -= getCurrentPieceValue(piece, i, j);
-      }
+  for (int color = 0; color < COLOR_COUNT; color++) {
+    for (int type = 0; type < PIECE_TYPE_COUNT; type++) {
+      const auto score =
+          simd::maskedSum(pieces[color][type], values[color][type].data());
+      evaluationScore += color == ownColor ? score : -score;
     }
   }
   return evaluationScore;
 }
 
+const PieceSquareValues &Computer::getPieceSquareValues() {
+  static const PieceSquareValues values = [] {
+    const std::string colors[COLOR_COUNT] = {WHITE, BLACK};
+    const std::string types[PIECE_TYPE_COUNT] = {PAWN, KNIGHT, BISHOP,
+                                                 ROOK, QUEEN,  KING};
+    PieceSquareValues table;
+    for (int color = 0; color < COLOR_COUNT; color++) {
+      for (int type = 0; type < PIECE_TYPE_COUNT; type++) {
+        const auto piece = Piece(types[type], colors[color]);
+        for (int i = 0; i < BOARD_LENGTH; i++) {
+          for (int j = 0; j < BOARD_LENGTH; j++) {
+            table[color][type][toSquareIndex(i, j)] =
+                getCurrentPieceValue(piece, i, j);
+          }
+        }
+      }
+    }
+    return table;
+  }();
+  return values;
+}
+
 int Computer::getCurrentPieceValue(const Piece &piece, int row, int col) {
 
   auto currentPieceValue = piece.getValue();
@@ -285,20 +721,93 @@ Computer::findAllMovablePieces(std::shared_ptr<Board> currentBoard) {
 
   std::map<std::string, std::vector<Square>> allMovablePieces;
 
-  for (int i = 0; i < BOARD_LENGTH; i++) {
-    for (int j = 0; j < BOARD_LENGTH; j++) {
-      const auto &piece = currentBoard->getSquare(i, j).getPiece();
-      if (piece.getColor() == currentBoard->getTurn()) {
-        auto moves = currentBoard->calcAndGetLegalMoves(i, j);
-        if (moves.size() > 0) {
-          std::string key = "";
-          key += std::to_string(i);
-          key += std::to_string(j);
-          allMovablePieces.insert({key, moves});
+  const auto &bitboards = currentBoard->getPieceBitboards();
+  auto pieces = bitboards.colors[colorToIndex(currentBoard->getTurn())];
+
+  while (pieces) {
+    const auto square = bitboard::popLowestSquare(pieces);
+    const auto i = square / BOARD_LENGTH;
+    const auto j = square % BOARD_LENGTH;
+    auto moves = currentBoard->calcAndGetLegalMoves(i, j);
+    if (moves.size() > 0) {
+      std::string key = "";
+      key += std::to_string(i);
+      key += std::to_string(j);
+      allMovablePieces.insert({key, moves});
+    }
+  }
+
+  return allMovablePieces;
+}
+
+// All legal moves, ordered so that captures that win or keep material come
+// first (best exchange first), then quiet moves and losing captures last.
+std::vector<Move> Computer::findAllMoves(std::shared_ptr<Board> currentBoard) {
+
+  std::vector<std::pair<int, Move>> scoredMoves;
+
+  for (auto const &pair : findAllMovablePieces(currentBoard)) {
+    int row = pair.first[0] - '0';
+    int col = pair.first[1] - '0';
+    for (auto const &square : pair.second) {
+      auto move = Move(row, col, square.getRow(), square.getCol());
+      int orderScore = 0;
+      if (currentBoard->isCapture(move)) {
+        auto see = currentBoard->see(move);
+        orderScore = see >= 0 ? see + 10000 : see - 10000;
+      }
+      scoredMoves.emplace_back(orderScore, move);
+    }
+  }
+
+  std::stable_sort(std::begin(scoredMoves), std::end(scoredMoves),
+                   [](const auto &a, const auto &b) { return a.first > b.first; });
+
+  std::vector<Move> moves;
+  moves.reserve(scoredMoves.size());
+  for (const auto &scoredMove : scoredMoves) {
+    moves.emplace_back(scoredMove.second);
+  }
+  return moves;
+}
+
+// Pseudo legal captures with a non negative exchange, best exchange first.
+// Legality is left to the caller so that pruned captures never pay for it.
+std::vector<Move>
+Computer::findGoodCaptures(std::shared_ptr<Board> currentBoard) {
+
+  const auto &bitboards = currentBoard->getPieceBitboards();
+  const auto occupied = bitboards.occupied();
+  const auto side = colorToIndex(currentBoard->getTurn());
+  const auto opponent = side == WHITE_INDEX ? BLACK_INDEX : WHITE_INDEX;
+
+  std::vector<std::pair<int, Move>> captures;
+
+  for (int type = 0; type < PIECE_TYPE_COUNT; type++) {
+    auto pieces = bitboards.pieces[side][type];
+    while (pieces) {
+      const auto from = bitboard::popLowestSquare(pieces);
+      auto targets = bitboard::pieceAttacks(side, type, from, occupied) &
+                     bitboards.colors[opponent];
+      while (targets) {
+        const auto to = bitboard::popLowestSquare(targets);
+        auto move = Move(from / BOARD_LENGTH, from % BOARD_LENGTH,
+                         to / BOARD_LENGTH, to % BOARD_LENGTH);
+        auto see = currentBoard->see(move);
+        if (see >= 0) {
+          captures.emplace_back(see, move);
         }
       }
     }
   }
 
-  return allMovablePieces;
+  std::stable_sort(std::begin(captures), std::end(captures),
+                   [](const auto &a, const auto &b) { return a.first > b.first; });
+
+  std::vector<Move> moves;
+  moves.reserve(captures.size());
+  for (const auto &capture : captures) {
+    moves.emplace_back(capture.second);
+  }
+  return moves;
 }
@@ -2,10 +2,41 @@
 #define COMPUTER_H
 #include "board.h"
 #include "piecePositions.h"
+#include "randomizer.h"
+#include "simd.h"
+#include "timeManager.h"
+#include "transpositionTable.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 
+// Piece value plus piece square bonus, per color, piece type and square.
+using PieceSquareValues = std::array<
+    std::array<std::array<int16_t, SQUARE_COUNT>, PIECE_TYPE_COUNT>,
+    COLOR_COUNT>;
+
+constexpr int INFINITE_SCORE = 999999;
+constexpr int MATE_SCORE = 100000;
+constexpr int MAX_DEPTH = 64;
+constexpr long STEP_CHECK_INTERVAL = 32;
+constexpr int STRENGTH_LEVEL_COUNT = 8;
+
+// A strength level fixes what a move costs instead of how long it takes: the
+// search stops at maxDepth or after nodeLimit nodes, however fast the host
+// is. With a randomMargin the move is picked at random among the root moves
+// that score within randomMargin of the best one.
+struct StrengthLevel {
+  int maxDepth = MAX_DEPTH;
+  long nodeLimit = 0;
+  int randomMargin = 0;
+};
+
+// A root move together with the board after it, its latest score and the
+// line the search expects after it, starting with the move itself.
 struct EvalInfo {
   EvalInfo() : move(Move(0, 0, 0, 0)) {}
   EvalInfo(std::shared_ptr<Board> board, Move move, int evaluationScore)
@@ -13,33 +44,186 @@ struct EvalInfo {
   std::shared_ptr<Board> board;
   Move move;
   int evaluationScore;
+  std::vector<Move> line;
   bool operator<(const EvalInfo &b) const {
     return this->evaluationScore < b.evaluationScore;
   }
 };
 
+// What a running search has found so far. depth is the last completed
+// depth, zero until the first one is done.
+struct SearchProgress {
+  SearchProgress() : bestMove(Move(0, 0, 0, 0)) {}
+  int depth = 0;
+  long nodes = 0;
+  int score = 0;
+  Move bestMove;
+};
+
+// A line of play the search expects, starting with a root move. The score
+// is from white's point of view: centipawns, or the number of moves to mate
+// when the search found one, positive when white mates.
+struct AnalysisLine {
+  std::vector<Move> moves;
+  int depth = 0;
+  int centipawns = 0;
+  int mateIn = 0;
+};
+
+// One completed depth of the iterative deepening. nodes and milliseconds
+// count this depth only.
+struct IterationStats {
+  int depth = 0;
+  long nodes = 0;
+  int milliseconds = 0;
+  int score = 0;
+};
+
+// Filled in by every search, for tuning the engine and noticing when a
+// change makes it slower. The effective branching factor is the node count
+// of the last completed depth divided by that of the depth before it.
+struct SearchStats {
+  int depth = 0;
+  long nodes = 0;
+  int milliseconds = 0;
+  long nodesPerSecond = 0;
+  double effectiveBranchingFactor = 0;
+  long tableProbes = 0;
+  long tableHits = 0;
+  double tableHitRate = 0;
+  long cutoffs = 0;
+  long firstMoveCutoffs = 0;
+  double firstMoveCutoffRate = 0;
+  std::vector<IterationStats> iterations;
+};
+
+using IterationCallback = std::function<void(const SearchStats &)>;
+
+// A node of the search on the explicit search stack. entered is set once the
+// node has been counted and its moves generated; nextMove is the next one of
+// them to search.
+struct SearchFrame {
+  std::shared_ptr<Board> board;
+  bool quiescence = false;
+  bool entered = false;
+  int depth = 0;
+  int alpha = 0;
+  int beta = 0;
+  int ply = 0;
+  int originalAlpha = 0;
+  int bestScore = -INFINITE_SCORE;
+  Move bestMove = Move(0, 0, 0, 0);
+  std::vector<Move> moves;
+  std::size_t nextMove = 0;
+  std::vector<Move> line;
+};
+
+// State shared between a searching Computer and the threads watching it.
+struct SearchControl {
+  std::atomic<bool> stopRequested{false};
+  std::atomic<bool> pondering{false};
+  std::mutex mutex;
+  SearchProgress progress;
+  SearchStats stats;
+  std::vector<AnalysisLine> lines;
+};
+
 class Computer {
 private:
   std::shared_ptr<Board> board;
   std::string color;
   std::chrono::milliseconds timePerMove;
+  TimeManager timeManager;
+  GameClock clock;
+  bool useClock = false;
+  long nodes = 0;
+  bool searchAborted = false;
+  // Shared so that Computer stays copyable, a copy that searches on another
+  // thread can still be stopped and watched through the original.
+  std::shared_ptr<SearchControl> control = std::make_shared<SearchControl>();
+  // Allocated by the first search, a computer that never searches does not
+  // pay for a table.
+  std::shared_ptr<TranspositionTable> table;
+  std::size_t tableSize = TranspositionTable::DEFAULT_SIZE;
+  std::vector<EvalInfo> rootMoves;
+  std::vector<SearchFrame> frames;
+  int rootDepth = 0;
+  std::size_t rootIndex = 0;
+  int rootAlpha = -INFINITE_SCORE;
+  Move bestMove = Move(0, 0, 0, 0);
+  bool searchFinished = true;
+  SearchStats stats;
+  std::chrono::steady_clock::time_point searchStartTime;
+  long iterationStartNodes = 0;
+  int iterationStartMilliseconds = 0;
+  IterationCallback iterationCallback;
+  int multiPv = 1;
+  bool useFixedLimits = false;
+  StrengthLevel limits;
+  std::vector<Move> nearBestMoves;
+  // Shared like control, so that a copy that searches on another thread
+  // advances the original's random numbers instead of repeating them.
+  std::shared_ptr<Randomizer> randomizer = std::make_shared<Randomizer>();
 
   Move getRandomMove();
 
-  Move getMaxMinMove();
+  std::vector<EvalInfo> calcRootMoves();
+
+  void finishSearch();
+
+  bool searchUntil(std::chrono::steady_clock::time_point deadline);
+
+  void startIteration(int depth);
+
+  void completeIteration();
+
+  void abortIteration();
+
+  void completeRootMove(int score, const std::vector<Move> &line);
+
+  void publishLines();
+
+  void collectNearBestMoves();
+
+  AnalysisLine toAnalysisLine(const EvalInfo &evalInfo);
+
+  void advance();
+
+  void pushFrame(std::shared_ptr<Board> board, int depth, int alpha, int beta,
+                 int ply, bool quiescence);
+
+  void enterFrame(SearchFrame &frame);
+
+  void returnScore(int score);
 
-  std::vector<EvalInfo> calcFirstMaxMinBatch();
+  void applyScore(int score, const std::vector<Move> &line = {});
 
-  Move maxMinSearch(std::vector<EvalInfo> topScores);
+  bool probeTable(SearchFrame &frame);
 
-  std::vector<EvalInfo> maxMinIteration(EvalInfo &evalInfo);
+  void storeFrame(const SearchFrame &frame, int score);
+
+  static int scoreToTable(int score, int ply);
+
+  static int scoreFromTable(int score, int ply);
+
+  bool countNode();
+
+  void publishProgress(int depth, const EvalInfo &best);
+
+  void updateStats();
 
   std::map<std::string, std::vector<Square>>
   findAllMovablePieces(std::shared_ptr<Board> board);
 
+  std::vector<Move> findAllMoves(std::shared_ptr<Board> board);
+
+  std::vector<Move> findGoodCaptures(std::shared_ptr<Board> board);
+
   int calcEvaluation(std::shared_ptr<Board> board);
 
-  int getCurrentPieceValue(const Piece &piece, int row, int col);
+  static int getCurrentPieceValue(const Piece &piece, int row, int col);
+
+  static const PieceSquareValues &getPieceSquareValues();
 
 public:
   Computer() = default;
@@ -47,6 +231,84 @@ public:
            std::chrono::milliseconds timePerMove);
 
   Move findMove();
+
+  // The same search in slices, for hosts that cannot block or run threads.
+  // Call step until it returns true, then getBestMove has the move.
+  void startSearch();
+
+  bool step(std::chrono::microseconds budget);
+
+  Move getBestMove() const;
+
+  bool isSearchFinished() const;
+
+  // Asks a running findMove to return as soon as possible. It still returns a
+  // legal move, the best one found so far. Safe to call from another thread.
+  // A stop that arrives while no search runs ends the next one instead, so
+  // clear it with resetStop before starting a search that may be stopped.
+  void stop();
+
+  void resetStop();
+
+  // Safe to call from another thread while findMove runs.
+  SearchProgress getProgress() const;
+
+  void setBoard(std::shared_ptr<Board> board);
+
+  // The statistics of the running search, or of the last one once it has
+  // finished. Safe to call from another thread.
+  SearchStats getStats() const;
+
+  // Called after every completed depth, on the thread that searches.
+  void setIterationCallback(IterationCallback callback);
+
+  // Levels run from 1, the weakest, to STRENGTH_LEVEL_COUNT. Level 0 goes
+  // back to searching on time.
+  void setStrengthLevel(int level);
+
+  static StrengthLevel getStrengthLevel(int level);
+
+  // Stops the search at maxDepth or after nodeLimit nodes instead of on
+  // time, 0 meaning no node limit. With a seed as well, the same position
+  // always gives the same move, line and node count.
+  void setSearchLimits(int maxDepth, long nodeLimit);
+
+  void setSeed(unsigned int seed);
+
+  // Searches the best count root moves with exact scores instead of only the
+  // best one, in the same search.
+  void setMultiPv(int count);
+
+  // The best lines of the last completed depth, best first, multiPv of them
+  // at most. Safe to call from another thread.
+  std::vector<AnalysisLine> getLines() const;
+
+  // While pondering the search ignores its time limits. Clearing the flag
+  // while the search runs makes it respect them again, counting the time
+  // already spent.
+  void setPondering(bool pondering);
+
+  // Searches with the given table instead of an own one. Computers that
+  // search on different threads may share a table, each then finds what the
+  // others have searched.
+  void setTable(std::shared_ptr<TranspositionTable> table);
+
+  // The table the computer searches with, allocated here if it has none yet.
+  // A copy that is given it with setTable shares what both searches learn.
+  std::shared_ptr<TranspositionTable> getTable();
+
+  bool hasTable() const;
+
+  // The number of entries of the table the computer allocates for itself, a
+  // power of two. Drops the table it has, the next search allocates one of
+  // the new size.
+  void setTableSize(std::size_t size);
+
+  // The best move the transposition table knows for the position, or
+  // Move(0, 0, 0, 0).
+  Move getTableMove(std::shared_ptr<Board> position);
+
+  void setClock(const GameClock &clock);
 };
 
 #endif // COMPUTER_H
\ No newline at end of file
@@ -1,9 +1,11 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
 constexpr int BOARD_LENGTH = 8;
+constexpr int SQUARE_COUNT = BOARD_LENGTH * BOARD_LENGTH;
 constexpr char WHITE[] = "White";
 constexpr char BLACK[] = "Black";
 constexpr char PAWN[] = "Pawn";
@@ -13,6 +15,26 @@ constexpr char ROOK[] = "Rook";
 constexpr char QUEEN[] = "Queen";
 constexpr char KING[] = "King";
 
+// Indexes used by the table driven parts of the engine. Squares are indexed
+// as row * BOARD_LENGTH + col, matching the row/col layout of Board.
+constexpr int COLOR_COUNT = 2;
+constexpr int WHITE_INDEX = 0;
+constexpr int BLACK_INDEX = 1;
+
+constexpr int PIECE_TYPE_COUNT = 6;
+constexpr int PAWN_INDEX = 0;
+constexpr int KNIGHT_INDEX = 1;
+constexpr int BISHOP_INDEX = 2;
+constexpr int ROOK_INDEX = 3;
+constexpr int QUEEN_INDEX = 4;
+constexpr int KING_INDEX = 5;
+
+// Im not sure if the king value is needed since my board stops the game before
+// the king is captured I need to add score if game is won/lost instead
+constexpr int PIECE_VALUES[PIECE_TYPE_COUNT] = {10, 32, 34, 50, 90, 1000};
+
+using Bitboard = std::uint64_t;
+
 constexpr char DRAW_BY_STALEMATE[] = "Draw by stalemate";
 constexpr char DRAW_BY_INSUFFICENT_MATING_MATERIAL[] =
     "Draw by insufficient mating material";
@@ -0,0 +1,205 @@
+#include "fen.h"
+
+static constexpr char PIECE_LETTERS[] = "PNBRQKpnbrqk";
+
+static bool isPieceLetter(char c) {
+  for (auto letter : std::string_view(PIECE_LETTERS)) {
+    if (c == letter) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Splits off the next field, fields are separated by spaces.
+static std::string_view nextField(std::string_view &fen) {
+  while (!fen.empty() && fen.front() == ' ') {
+    fen.remove_prefix(1);
+  }
+  auto length = fen.find(' ');
+  if (length == std::string_view::npos) {
+    length = fen.size();
+  }
+  const auto field = fen.substr(0, length);
+  fen.remove_prefix(length);
+  return field;
+}
+
+static bool parseNumber(std::string_view field, int minimum, int &number) {
+  if (field.empty() || field.size() > 6) {
+    return false;
+  }
+  number = 0;
+  for (auto c : field) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    number = number * 10 + c - '0';
+  }
+  return number >= minimum;
+}
+
+static bool parsePlacement(std::string_view field, FenPosition &position) {
+  int row = 0;
+  int col = 0;
+  int kings[COLOR_COUNT] = {};
+  for (auto c : field) {
+    if (c == '/') {
+      if (col != BOARD_LENGTH || ++row >= BOARD_LENGTH) {
+        return false;
+      }
+      col = 0;
+    } else if (c >= '1' && c <= '8') {
+      for (int i = 0; i < c - '0'; i++) {
+        if (col >= BOARD_LENGTH) {
+          return false;
+        }
+        position.pieces[row * BOARD_LENGTH + col++] = ' ';
+      }
+    } else if (isPieceLetter(c)) {
+      const auto isPawn = c == 'P' || c == 'p';
+      if (col >= BOARD_LENGTH ||
+          (isPawn && (row == 0 || row == BOARD_LENGTH - 1))) {
+        return false;
+      }
+      if (c == 'K' || c == 'k') {
+        kings[c == 'K' ? WHITE_INDEX : BLACK_INDEX]++;
+      }
+      position.pieces[row * BOARD_LENGTH + col++] = c;
+    } else {
+      return false;
+    }
+  }
+  return row == BOARD_LENGTH - 1 && col == BOARD_LENGTH &&
+         kings[WHITE_INDEX] == 1 && kings[BLACK_INDEX] == 1;
+}
+
+static bool parseCastling(std::string_view field, FenPosition &position) {
+  if (field == "-") {
+    return true;
+  }
+  if (field.empty()) {
+    return false;
+  }
+  for (auto c : field) {
+    const auto color = c == 'K' || c == 'Q' ? WHITE_INDEX : BLACK_INDEX;
+    const auto side = c == 'K' || c == 'k' ? KING_SIDE : QUEEN_SIDE;
+    const auto row = color == WHITE_INDEX ? BOARD_LENGTH - 1 : 0;
+    const auto king = color == WHITE_INDEX ? 'K' : 'k';
+    const auto rook = color == WHITE_INDEX ? 'R' : 'r';
+    const auto rookCol = side == KING_SIDE ? BOARD_LENGTH - 1 : 0;
+    if ((c != 'K' && c != 'Q' && c != 'k' && c != 'q') ||
+        position.castling[color][side] ||
+        position.pieces[row * BOARD_LENGTH + 4] != king ||
+        position.pieces[row * BOARD_LENGTH + rookCol] != rook) {
+      return false;
+    }
+    position.castling[color][side] = true;
+  }
+  return true;
+}
+
+// The square must be empty, with the pawn that made the double step in front
+// of it and the square it came from empty.
+static bool parseEnPassant(std::string_view field, FenPosition &position) {
+  if (field == "-") {
+    return true;
+  }
+  if (field.size() != 2 || field[0] < 'a' || field[0] > 'h') {
+    return false;
+  }
+  const auto row = position.whiteToMove ? 2 : 5;
+  if (field[1] != '8' - row) {
+    return false;
+  }
+  const auto col = field[0] - 'a';
+  const auto forward = position.whiteToMove ? BOARD_LENGTH : -BOARD_LENGTH;
+  const auto square = row * BOARD_LENGTH + col;
+  if (position.pieces[square] != ' ' ||
+      position.pieces[square - forward] != ' ' ||
+      position.pieces[square + forward] != (position.whiteToMove ? 'p' : 'P')) {
+    return false;
+  }
+  position.enPassantSquare = square;
+  return true;
+}
+
+bool parseFen(std::string_view fen, FenPosition &position) {
+  position = FenPosition();
+
+  if (!parsePlacement(nextField(fen), position)) {
+    return false;
+  }
+
+  const auto side = nextField(fen);
+  if (side != "w" && side != "b") {
+    return false;
+  }
+  position.whiteToMove = side == "w";
+
+  if (!parseCastling(nextField(fen), position) ||
+      !parseEnPassant(nextField(fen), position)) {
+    return false;
+  }
+
+  const auto halfmoveClock = nextField(fen);
+  const auto fullmoveNumber = nextField(fen);
+  if (!halfmoveClock.empty() &&
+      (!parseNumber(halfmoveClock, 0, position.halfmoveClock) ||
+       !parseNumber(fullmoveNumber, 1, position.fullmoveNumber))) {
+    return false;
+  }
+  return nextField(fen).empty();
+}
+
+std::string formatFen(const FenPosition &position) {
+  std::string fen;
+  for (int row = 0; row < BOARD_LENGTH; row++) {
+    int emptySquares = 0;
+    for (int col = 0; col < BOARD_LENGTH; col++) {
+      const auto piece = position.pieces[row * BOARD_LENGTH + col];
+      if (piece == ' ') {
+        emptySquares++;
+        continue;
+      }
+      if (emptySquares > 0) {
+        fen += static_cast<char>('0' + emptySquares);
+        emptySquares = 0;
+      }
+      fen += piece;
+    }
+    if (emptySquares > 0) {
+      fen += static_cast<char>('0' + emptySquares);
+    }
+    if (row < BOARD_LENGTH - 1) {
+      fen += '/';
+    }
+  }
+
+  fen += position.whiteToMove ? " w " : " b ";
+
+  const auto castlingStart = fen.size();
+  constexpr char letters[COLOR_COUNT][2] = {{'K', 'Q'}, {'k', 'q'}};
+  for (int color = 0; color < COLOR_COUNT; color++) {
+    for (int side = 0; side < 2; side++) {
+      if (position.castling[color][side]) {
+        fen += letters[color][side];
+      }
+    }
+  }
+  if (fen.size() == castlingStart) {
+    fen += '-';
+  }
+
+  fen += ' ';
+  if (position.enPassantSquare >= 0) {
+    fen += static_cast<char>('a' + position.enPassantSquare % BOARD_LENGTH);
+    fen += static_cast<char>('8' - position.enPassantSquare / BOARD_LENGTH);
+  } else {
+    fen += '-';
+  }
+
+  fen += ' ' + std::to_string(position.halfmoveClock) + ' ' +
+         std::to_string(position.fullmoveNumber);
+  return fen;
+}
@@ -0,0 +1,33 @@
+#ifndef FEN_H
+#define FEN_H
+#include "constants.h"
+#include <string>
+#include <string_view>
+
+constexpr char START_FEN[] =
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+constexpr int KING_SIDE = 0;
+constexpr int QUEEN_SIDE = 1;
+
+// A position as written in FEN. pieces holds the FEN letter of the piece on
+// each square, row * BOARD_LENGTH + col, or ' ' when the square is empty.
+struct FenPosition {
+  char pieces[SQUARE_COUNT] = {};
+  bool whiteToMove = true;
+  bool castling[COLOR_COUNT][2] = {};
+  int enPassantSquare = -1;
+  int halfmoveClock = 0;
+  int fullmoveNumber = 1;
+};
+
+// Parses and checks a FEN without allocating. Returns false unless the
+// position has one king of each color, no pawns on the first or last rank,
+// castling rights that match the kings and rooks and an en passant square
+// behind a pawn that just made a double step. The clocks may be left out,
+// as in EPD.
+bool parseFen(std::string_view fen, FenPosition &position);
+
+std::string formatFen(const FenPosition &position);
+
+#endif // FEN_H
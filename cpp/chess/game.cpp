@@ -2,23 +2,66 @@
 
 Game::Game() { board = std::make_shared<Board>(); }
 
+// A ponder search only ends when it is stopped.
+Game::~Game() { cancelComputerMove(); }
+
 void Game::newGame(std::string playerColor, int timePerMove,
-                   bool useOpeningBook) {
+                   bool useOpeningBook, int strengthLevel) {
+  cancelComputerMove();
   this->playerColor = playerColor;
   computerColor = playerColor == WHITE ? BLACK : WHITE;
   board = std::make_shared<Board>();
+
+  // The last game's table is emptied and kept rather than allocated again.
+  auto table = sharedTable;
+  if (!table && computer.hasTable()) {
+    table = computer.getTable();
+    table->clear();
+  }
   computer =
       Computer(board, computerColor, std::chrono::milliseconds(timePerMove));
+  computer.setStrengthLevel(strengthLevel);
+  if (table) {
+    computer.setTable(table);
+  }
 
   openingBook.reset(useOpeningBook);
+  if (seeded) {
+    computer.setSeed(seed);
+    openingBook.setSeed(seed);
+  }
 }
 
+// Switches the computer from a fixed time per move to its game clock. The
+// host reports the clock before each computer move.
+void Game::setComputerClock(int remainingTime, int increment, int movesToGo) {
+  GameClock clock;
+  clock.remaining = std::chrono::milliseconds(remainingTime);
+  clock.increment = std::chrono::milliseconds(increment);
+  clock.movesToGo = movesToGo;
+  computer.setClock(clock);
+}
+
+// Moves are not taken on the computer's turn, and a rejected move leaves the
+// computer's search alone. A move that leads to the position the computer is
+// pondering turns the ponder search into the search for the computer's move;
+// any other move cancels it.
 GameInfo Game::makeAMove(int startR, int startC, int endR, int endC) {
-  if (openingBook.getIsActive()) {
-    openingBook.traverse(Move(startR, startC, endR, endC));
+  const auto turn = board->getTurn();
+  if (turn == computerColor) {
+    return board->getGameInfo();
   }
-
-  return board->makeAMove(startR, startC, endR, endC);
+  auto gameInfo = board->makeAMove(startR, startC, endR, endC);
+  if (board->getTurn() == turn) {
+    return gameInfo;
+  }
+  if (pondering && board->getHash() == ponderHash) {
+    pondering = false;
+    computer.setPondering(false);
+  } else {
+    cancelComputerMove();
+  }
+  return gameInfo;
 }
 
 void Game::setPromotionType(std::string type) { board->setPromotionType(type); }
@@ -34,21 +77,216 @@ Squares Game::getSquares() const { return board->getSquares(); }
 
 std::string Game::getTurn() { return board->getTurn(); }
 
+// Searches on the caller's thread, without pausing, and plays the move.
 GameInfo Game::makeComputerMove() {
+  if (!pendingMove.valid()) {
+    while (!stepComputerMove(std::numeric_limits<int>::max())) {
+    }
+  }
+  return waitComputerMove();
+}
+
+// Starts looking for the computer's move on a worker thread and returns at
+// once. The worker searches a copy of the board, so the game can still be
+// read while it runs, with the computer's own transposition table. Nothing
+// happens if it is not the computer's turn or a move is already on its way.
+void Game::startComputerMove() {
+
+  if (pendingMove.valid() || computerSearching ||
+      board->getTurn() != computerColor || takeBookMove()) {
+    return;
+  }
+
+  auto searcher = computer;
+  searcher.setTable(computer.getTable());
+  searcher.setBoard(std::make_shared<Board>(board));
+  computer.resetStop();
+  pendingMove = std::async(std::launch::async, [searcher]() mutable {
+    return searcher.findMove();
+  });
+}
 
+// Looks for the computer's move on the caller's thread for about
+// budgetMicroseconds and returns whether the move is ready. For hosts without
+// threads: call it from the event loop until it returns true, then play the
+// move with waitComputerMove.
+bool Game::stepComputerMove(int budgetMicroseconds) {
+
+  if (pendingMove.valid()) {
+    return isComputerMoveReady();
+  }
   if (board->getTurn() != computerColor) {
-    return board->getGameInfo();
+    return true;
   }
 
-  Move move;
-  if (openingBook.getIsActive() && !openingBook.outOfMoves()) {
-    move = openingBook.findMove();
-    openingBook.traverse(move);
-  } else {
-    move = computer.findMove();
+  if (!computerSearching) {
+    if (takeBookMove()) {
+      return true;
+    }
+    computer.resetStop();
+    computer.startSearch();
+    computerSearching = true;
+  }
+
+  if (!computer.step(std::chrono::microseconds(budgetMicroseconds))) {
+    return false;
+  }
+  computerSearching = false;
+  setPendingMove(computer.getBestMove());
+  return true;
+}
+
+// A book move is only trusted when it is legal, in case two positions share a
+// hash.
+bool Game::takeBookMove() {
+  if (!openingBook.getIsActive()) {
+    return false;
+  }
+
+  const auto move = openingBook.findMove(board->getHash());
+  if (move == Move(0, 0, 0, 0)) {
+    return false;
+  }
+  const auto legalMoves =
+      board->calcAndGetLegalMoves(move.startRow, move.startCol);
+  const auto isLegal = std::any_of(begin(legalMoves), end(legalMoves),
+                                   [&move](const Square &square) {
+                                     return square.getRow() == move.endRow &&
+                                            square.getCol() == move.endCol;
+                                   });
+  if (!isLegal) {
+    return false;
+  }
+  setPendingMove(move);
+  return true;
+}
+
+void Game::setPendingMove(const Move &move) {
+  std::promise<Move> foundMove;
+  foundMove.set_value(move);
+  pendingMove = foundMove.get_future();
+}
+
+bool Game::isComputerMoveReady() {
+  return !pendingMove.valid() || pondering ||
+         pendingMove.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+}
+
+// Blocks until the computer has found its move and plays it.
+GameInfo Game::waitComputerMove() {
+
+  if (!pendingMove.valid() || pondering) {
+    return board->getGameInfo();
   }
 
+  auto move = pendingMove.get();
+  board->setPromotionType(QUEEN);
   auto moves = board->calcAndGetLegalMoves(move.startRow, move.startCol);
-  return board->makeAMove(move.startRow, move.startCol, move.endRow,
-                          move.endCol);
-}
\ No newline at end of file
+  auto gameInfo = board->makeAMove(move.startRow, move.startCol, move.endRow,
+                                   move.endCol);
+  if (ponderingEnabled) {
+    startPondering(move);
+  }
+  return gameInfo;
+}
+
+// Guesses the player's reply, the second move of the line the computer
+// expects, and searches the position after it on a worker thread while the
+// player thinks. The ponder search shares the transposition table, so even a
+// cancelled one leaves useful entries behind.
+void Game::startPondering(const Move &playedMove) {
+
+  ponderMove = computer.getTableMove(board);
+  const auto lines = computer.getLines();
+  if (!lines.empty() && lines[0].moves.size() >= 2 &&
+      lines[0].moves[0] == playedMove) {
+    ponderMove = lines[0].moves[1];
+  }
+  if (ponderMove == Move(0, 0, 0, 0)) {
+    return;
+  }
+
+  auto ponderBoard = std::make_shared<Board>(board);
+  ponderBoard->setPromotionType(QUEEN);
+  ponderBoard->makeSearchMove(ponderMove);
+  ponderHash = ponderBoard->getHash();
+
+  auto searcher = computer;
+  searcher.setTable(computer.getTable());
+  searcher.setBoard(ponderBoard);
+  computer.resetStop();
+  computer.setPondering(true);
+  pondering = true;
+  pendingMove = std::async(std::launch::async, [searcher]() mutable {
+    return searcher.findMove();
+  });
+}
+
+// Pondering needs a worker thread, so only enable it in threaded builds.
+void Game::setPondering(bool enabled) {
+  ponderingEnabled = enabled;
+  if (!enabled && pondering) {
+    cancelComputerMove();
+  }
+}
+
+// The reply the computer is pondering on, Move(0, 0, 0, 0) when it is not.
+Move Game::getPonderMove() const {
+  return pondering ? ponderMove : Move(0, 0, 0, 0);
+}
+
+void Game::setSeed(unsigned int seed) {
+  seeded = true;
+  this->seed = seed;
+  computer.setSeed(seed);
+  openingBook.setSeed(seed);
+}
+
+void Game::setTable(std::shared_ptr<TranspositionTable> table) {
+  sharedTable = table;
+  computer.setTable(table);
+}
+
+bool Game::loadOpeningBook(std::string path) {
+  return openingBook.loadFile(path);
+}
+
+void Game::setBestBookMoves(bool bestOnly) {
+  openingBook.setBestOnly(bestOnly);
+}
+
+SearchProgress Game::getSearchProgress() const {
+  return computer.getProgress();
+}
+
+SearchStats Game::getSearchStats() const { return computer.getStats(); }
+
+void Game::setMultiPv(int count) { computer.setMultiPv(count); }
+
+std::vector<AnalysisLine> Game::getAnalysisLines() const {
+  return computer.getLines();
+}
+
+// The callback runs on the thread that searches, which is a worker thread
+// for startComputerMove and pondering.
+void Game::setIterationCallback(IterationCallback callback) {
+  computer.setIterationCallback(callback);
+}
+
+// Throws away a computer move that has not been played yet.
+void Game::cancelComputerMove() {
+  computerSearching = false;
+  if (pendingMove.valid()) {
+    computer.stop();
+    pendingMove.wait();
+    pendingMove = std::future<Move>();
+  }
+  pondering = false;
+  computer.setPondering(false);
+}
+
+// Makes a running search play the best move it has found so far. Call it
+// before starting a new game, resigning or taking back a move so they do not
+// have to wait for the search.
+void Game::stopSearch() { computer.stop(); }
@@ -3,6 +3,8 @@
 #include "board.h"
 #include "computer.h"
 #include "openingBook.h"
+#include <future>
+#include <limits>
 #include <memory>
 
 class Game {
@@ -12,13 +14,76 @@ private:
   std::string playerColor;
   std::string computerColor;
   OpeningBook openingBook;
+  std::future<Move> pendingMove;
+  bool computerSearching = false;
+  bool ponderingEnabled = false;
+  bool pondering = false;
+  Move ponderMove = Move(0, 0, 0, 0);
+  std::uint64_t ponderHash = 0;
+  bool seeded = false;
+  unsigned int seed = 0;
+  std::shared_ptr<TranspositionTable> sharedTable;
+
+  void startPondering(const Move &playedMove);
+
+  bool takeBookMove();
+
+  void setPendingMove(const Move &move);
+
+  void cancelComputerMove();
 
 public:
   Game();
+  ~Game();
 
   GameInfo makeComputerMove();
 
-  void newGame(std::string color, int timePerMove, bool useOpeningBook);
+  void startComputerMove();
+
+  bool stepComputerMove(int budgetMicroseconds);
+
+  bool isComputerMoveReady();
+
+  GameInfo waitComputerMove();
+
+  SearchProgress getSearchProgress() const;
+
+  SearchStats getSearchStats() const;
+
+  void setMultiPv(int count);
+
+  std::vector<AnalysisLine> getAnalysisLines() const;
+
+  void setIterationCallback(IterationCallback callback);
+
+  void stopSearch();
+
+  void setPondering(bool enabled);
+
+  Move getPonderMove() const;
+
+  // Seeds the computer and the opening book, now and in every new game, so
+  // that games can be replayed.
+  void setSeed(unsigned int seed);
+
+  // Searches with a table shared with other games, now and in every new
+  // game, instead of one of its own.
+  void setTable(std::shared_ptr<TranspositionTable> table);
+
+  // Maps a binary opening book from the file system, see BookFile. It is
+  // asked before the built-in lines while the opening book is in use.
+  bool loadOpeningBook(std::string path);
+
+  // Plays only the book move with the highest weight instead of picking
+  // moves in proportion to their weights.
+  void setBestBookMoves(bool bestOnly);
+
+  // A strengthLevel from 1 to STRENGTH_LEVEL_COUNT fixes the work per move
+  // and overrides timePerMove; 0 plays on time.
+  void newGame(std::string color, int timePerMove, bool useOpeningBook,
+               int strengthLevel = 0);
+
+  void setComputerClock(int remainingTime, int increment, int movesToGo);
 
   GameInfo makeAMove(int startR, int startC, int endR, int endC);
 
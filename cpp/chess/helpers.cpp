@@ -13,6 +13,34 @@ bool isInsideBoard(int row, int col) {
   return row > -1 && col > -1 && row < BOARD_LENGTH && col < BOARD_LENGTH;
 }
 
+int toSquareIndex(int row, int col) { return row * BOARD_LENGTH + col; }
+
+int colorToIndex(const std::string &color) {
+  return color == WHITE ? WHITE_INDEX : BLACK_INDEX;
+}
+
+int pieceTypeToIndex(const std::string &type) {
+  if (type == PAWN) {
+    return PAWN_INDEX;
+  }
+  if (type == KNIGHT) {
+    return KNIGHT_INDEX;
+  }
+  if (type == BISHOP) {
+    return BISHOP_INDEX;
+  }
+  if (type == ROOK) {
+    return ROOK_INDEX;
+  }
+  if (type == QUEEN) {
+    return QUEEN_INDEX;
+  }
+  if (type == KING) {
+    return KING_INDEX;
+  }
+  return -1;
+}
+
 std::queue<Move> stringToMoves(const std::string &moves) {
 
   std::queue<Move> convertedMoves;
@@ -36,3 +64,10 @@ std::queue<Move> stringToMoves(const std::string &moves) {
 
   return convertedMoves;
 }
+
+std::string moveToCoordinates(const Move &move) {
+  return {static_cast<char>('a' + move.startCol),
+          static_cast<char>('8' - move.startRow),
+          static_cast<char>('a' + move.endCol),
+          static_cast<char>('8' - move.endRow)};
+}
@@ -12,6 +12,15 @@ int sanitizeBoardLength(int number);
 
 bool isInsideBoard(int row, int col);
 
+int toSquareIndex(int row, int col);
+
+int colorToIndex(const std::string &color);
+
+int pieceTypeToIndex(const std::string &type);
+
 std::queue<Move> stringToMoves(const std::string &moves);
 
+// The move in coordinate notation, such as "e2e4".
+std::string moveToCoordinates(const Move &move);
+
 #endif
\ No newline at end of file
@@ -8,4 +8,9 @@ Move::Move(std::string player, int startRow, int startCol, int endRow,
       pieceTypeCaptured(pieceTypeCaptured) {}
 
 Move::Move(int startRow, int startCol, int endRow, int endCol)
-    : startRow(startRow), startCol(startCol), endRow(endRow), endCol(endCol) {}
\ No newline at end of file
+    : startRow(startRow), startCol(startCol), endRow(endRow), endCol(endCol) {}
+
+bool Move::operator==(const Move &other) const {
+  return startRow == other.startRow && startCol == other.startCol &&
+         endRow == other.endRow && endCol == other.endCol;
+}
\ No newline at end of file
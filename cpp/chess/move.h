@@ -8,6 +8,8 @@ public:
   Move(std::string player, int startRow, int startCol, int endRow, int endCol,
        std::string pieceTypeMoved, std::string pieceTypeCaptured);
   Move(int startRow, int startCol, int endRow, int endCol);
+  // Moves are equal when they go between the same squares.
+  bool operator==(const Move &other) const;
   std::string player;
   int startRow;
   int startCol;
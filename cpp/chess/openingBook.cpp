@@ -1,78 +1,209 @@
 #include "openingBook.h"
+#include "openings.h"
+#include "zobrist.h"
+#include <algorithm>
 
-Node::Node(Move move) : move(move) {}
+static bool compareKeys(const BookEntry &a, const BookEntry &b) {
+  return a.key < b.key;
+}
 
-void Node::addLine(std::queue<Move> moves) {
+namespace {
 
-  if (moves.size() > 0) {
+// The built-in lines are replayed by the compiler into entries sorted by the
+// hash of the position each move is played in, so a book costs nothing to
+// construct. The moves are read like stringToMoves reads them, and only the
+// hash of each position is kept track of, which is all the book needs.
 
-    auto move = moves.front();
-    moves.pop();
+constexpr std::size_t countLineMoves() {
+  std::size_t count = 0;
+  for (const auto opening : openings) {
+    for (auto c = opening; *c != '\0'; c++) {
+      count += *c == '-';
+    }
+  }
+  return count;
+}
 
-    auto findMove = [move](std::shared_ptr<Node> node) {
-      auto &m = node->move;
-      return m.startRow == move.startRow && m.startCol == move.startCol &&
-             m.endRow == move.endRow && m.endCol == move.endCol;
-    };
+constexpr int EMPTY = -1;
 
-    nexts.push_back(std::make_shared<Node>(move));
-    auto iterator = std::find_if(begin(nexts), end(nexts), findMove);
+struct LinePosition {
+  int pieces[SQUARE_COUNT] = {};
+  std::uint64_t hash = 0;
 
-    if (iterator == std::end(nexts)) {
-      auto newNode = std::make_shared<Node>(move);
-      newNode->addLine(moves);
-      nexts.emplace_back(newNode);
-    } else {
-      (*iterator)->addLine(moves);
+  constexpr LinePosition() {
+    constexpr int backRank[BOARD_LENGTH] = {
+        ROOK_INDEX, KNIGHT_INDEX, BISHOP_INDEX, QUEEN_INDEX,
+        KING_INDEX, BISHOP_INDEX, KNIGHT_INDEX, ROOK_INDEX};
+    for (int square = 0; square < SQUARE_COUNT; square++) {
+      pieces[square] = EMPTY;
+    }
+    for (int col = 0; col < BOARD_LENGTH; col++) {
+      place(BLACK_INDEX, backRank[col], col);
+      place(BLACK_INDEX, PAWN_INDEX, BOARD_LENGTH + col);
+      place(WHITE_INDEX, PAWN_INDEX, 6 * BOARD_LENGTH + col);
+      place(WHITE_INDEX, backRank[col], 7 * BOARD_LENGTH + col);
     }
   }
-}
 
-OpeningBook::OpeningBook() {
-  rootNode = std::make_shared<Node>();
+  constexpr void place(int color, int type, int square) {
+    pieces[square] = color * PIECE_TYPE_COUNT + type;
+    hash ^= zobrist::pieceKey(color, type, square);
+  }
 
-  for (const auto &opening : openings) {
-    rootNode->addLine(stringToMoves(opening));
+  constexpr void remove(int square) {
+    const auto piece = pieces[square];
+    hash ^= zobrist::pieceKey(piece / PIECE_TYPE_COUNT,
+                              piece % PIECE_TYPE_COUNT, square);
+    pieces[square] = EMPTY;
   }
-  currentNode = rootNode;
-}
 
-bool OpeningBook::outOfMoves() {
-  return currentNode == nullptr || currentNode->nexts.size() == 0;
+  // Castling moves the rook as well, en passant takes the pawn beside the
+  // start square and pawns promote to queens, as on Board.
+  constexpr void makeMove(int from, int to) {
+    const auto color = pieces[from] / PIECE_TYPE_COUNT;
+    auto type = pieces[from] % PIECE_TYPE_COUNT;
+    const auto fromCol = from % BOARD_LENGTH;
+    const auto toCol = to % BOARD_LENGTH;
+    const auto toRow = to / BOARD_LENGTH;
+
+    remove(from);
+    if (pieces[to] != EMPTY) {
+      remove(to);
+    } else if (type == PAWN_INDEX && fromCol != toCol) {
+      remove(from - fromCol + toCol);
+    }
+    if (type == KING_INDEX && (toCol - fromCol == 2 || fromCol - toCol == 2)) {
+      const auto rookFrom = toCol > fromCol ? to + 1 : to - 2;
+      const auto rookTo = toCol > fromCol ? to - 1 : to + 1;
+      remove(rookFrom);
+      place(color, ROOK_INDEX, rookTo);
+    }
+    if (type == PAWN_INDEX && (toRow == 0 || toRow == BOARD_LENGTH - 1)) {
+      type = QUEEN_INDEX;
+    }
+    place(color, type, to);
+    hash ^= zobrist::sideKey();
+  }
+};
+
+struct BuiltInBook {
+  BookEntry entries[countLineMoves()] = {};
+  std::size_t count = 0;
+
+  constexpr BuiltInBook() {
+    for (const auto opening : openings) {
+      LinePosition position;
+      int squares[4] = {};
+      int length = 0;
+      for (auto c = opening; *c != '\0'; c++) {
+        if (*c >= 'a' && *c <= 'h') {
+          squares[length++] = *c - 'a';
+        } else if (*c >= '1' && *c <= '8') {
+          squares[length++] = '8' - *c;
+        }
+        if (length == 4) {
+          const auto from = squares[1] * BOARD_LENGTH + squares[0];
+          const auto to = squares[3] * BOARD_LENGTH + squares[2];
+          add(position.hash, from + to * SQUARE_COUNT);
+          position.makeMove(from, to);
+          length = 0;
+        }
+      }
+    }
+  }
+
+  // Keeps the entries sorted. A move shared by several lines is stored once,
+  // weighted by the number of lines.
+  constexpr void add(std::uint64_t key, std::uint16_t move) {
+    auto index = count;
+    for (std::size_t i = 0; i < count; i++) {
+      if (entries[i].key == key && entries[i].move == move) {
+        entries[i].weight++;
+        return;
+      }
+    }
+    while (index > 0 && entries[index - 1].key > key) {
+      entries[index] = entries[index - 1];
+      index--;
+    }
+    entries[index].key = key;
+    entries[index].move = move;
+    entries[index].weight = 1;
+    entries[index].wins = 0;
+    entries[index].draws = 0;
+    entries[index].losses = 0;
+    count++;
+  }
+};
+
+constexpr BuiltInBook builtInBook;
+
+} // namespace
+
+Move OpeningBook::findMove(std::uint64_t hash) {
+  return pickMove(findEntries(hash));
 }
 
-Move OpeningBook::findMove() {
+std::vector<BookEntry> OpeningBook::findEntries(std::uint64_t hash) const {
+
+  if (bookFile != nullptr) {
+    auto entries = bookFile->probe(hash);
+    if (!entries.empty()) {
+      return entries;
+    }
+  }
 
-  const auto index =
-      randomizer.generateRandomNumber(0, currentNode->nexts.size() - 1);
-  return currentNode->nexts[index]->move;
+  BookEntry wanted;
+  wanted.key = hash;
+  const auto range =
+      std::equal_range(builtInBook.entries,
+                       builtInBook.entries + builtInBook.count, wanted,
+                       compareKeys);
+  return std::vector<BookEntry>(range.first, range.second);
 }
 
-void OpeningBook::traverse(Move move) {
+Move OpeningBook::pickMove(const std::vector<BookEntry> &entries) {
 
-  if (currentNode == nullptr) {
-    return;
+  int totalWeight = 0;
+  for (const auto &entry : entries) {
+    totalWeight += entry.weight;
+  }
+  if (totalWeight == 0) {
+    return Move(0, 0, 0, 0);
+  }
+
+  if (bestOnly) {
+    const auto best = std::max_element(
+        begin(entries), end(entries),
+        [](const BookEntry &a, const BookEntry &b) {
+          return a.weight < b.weight;
+        });
+    return best->getMove();
   }
 
-  auto findMove = [move](std::shared_ptr<Node> node) {
-    auto &m = node->move;
-    return m.startRow == move.startRow && m.startCol == move.startCol &&
-           m.endRow == move.endRow && m.endCol == move.endCol;
-  };
-  auto iterator = std::find_if(begin(currentNode->nexts),
-                               end(currentNode->nexts), findMove);
-
-  if (iterator == std::end(currentNode->nexts)) {
-    currentNode = nullptr;
-  } else {
-    int index = std::distance(begin(currentNode->nexts), iterator);
-    currentNode = currentNode->nexts[index];
+  auto pick = randomizer.generateRandomNumber(0, totalWeight - 1);
+  for (const auto &entry : entries) {
+    if (pick < entry.weight) {
+      return entry.getMove();
+    }
+    pick -= entry.weight;
   }
+  return Move(0, 0, 0, 0);
 }
 
+void OpeningBook::setBestOnly(bool bestOnly) { this->bestOnly = bestOnly; }
+
 bool OpeningBook::getIsActive() { return isActive; }
 
-void OpeningBook::reset(bool isActive) {
-  this->isActive = isActive;
-  currentNode = rootNode;
+void OpeningBook::reset(bool isActive) { this->isActive = isActive; }
+
+void OpeningBook::setSeed(unsigned int seed) { randomizer.setSeed(seed); }
+
+bool OpeningBook::loadFile(const std::string &path) {
+  auto file = std::make_shared<BookFile>();
+  if (!file->open(path)) {
+    return false;
+  }
+  bookFile = file;
+  return true;
 }
@@ -1,42 +1,47 @@
 #ifndef OPENING_BOOK_H
 #define OPENING_BOOK_H
+#include "bookFile.h"
 #include "helpers.h"
 #include "move.h"
-#include "openings.h"
 #include "randomizer.h"
 #include <memory>
 #include <vector>
 
-class Node {
-private:
-public:
-  std::vector<std::shared_ptr<Node>> nexts;
-  Node() = default;
-  Node(Move move);
-
-  Move move;
-  void addLine(std::queue<Move> moves);
-};
-
+// Knows moves by the position they are played in rather than by the moves
+// that led there, so the book is still used after a transposition or when a
+// game starts from a position. The built-in lines from openings.h are looked
+// up the same way as the entries of a book file.
 class OpeningBook {
 private:
-  std::shared_ptr<Node> currentNode;
-  std::shared_ptr<Node> rootNode;
+  std::shared_ptr<BookFile> bookFile;
   Randomizer randomizer;
   bool isActive;
+  bool bestOnly = false;
 
-public:
-  OpeningBook();
+  Move pickMove(const std::vector<BookEntry> &entries);
 
-  bool outOfMoves();
+public:
+  // Picks one of the book's moves for the position: the one with the highest
+  // weight when only the best moves are played, otherwise each with a chance
+  // in proportion to its weight. The null move when the book does not know
+  // the position.
+  Move findMove(std::uint64_t hash);
 
-  Move findMove();
+  // The moves the book knows for the position, with their weights and
+  // results. A loaded book file replaces the built-in lines for the
+  // positions it knows.
+  std::vector<BookEntry> findEntries(std::uint64_t hash) const;
 
-  void traverse(Move move);
+  void setBestOnly(bool bestOnly);
 
   bool getIsActive();
 
   void reset(bool isActive);
+
+  void setSeed(unsigned int seed);
+
+  // Maps a binary book, see BookFile. Returns false when path is not one.
+  bool loadFile(const std::string &path);
 };
 
-#endif // OPENING_BOOK_H
\ No newline at end of file
+#endif // OPENING_BOOK_H
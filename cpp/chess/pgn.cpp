@@ -0,0 +1,389 @@
+#include "pgn.h"
+#include <algorithm>
+
+std::string_view PgnGame::getTag(std::string_view name) const {
+  for (const auto &tag : tags) {
+    if (tag.first == name) {
+      return tag.second;
+    }
+  }
+  return "";
+}
+
+static constexpr std::size_t CHUNK_SIZE = std::size_t(1) << 16;
+
+PgnReader::PgnReader(std::istream &input)
+    : input(input), buffer(CHUNK_SIZE) {}
+
+static bool isResult(std::string_view token) {
+  return token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+static bool isSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static bool isDelimiter(char c) {
+  return isSpace(c) || c == '{' || c == '}' || c == '(' || c == ')' ||
+         c == ';' || c == '[' || c == ']' || c == '$';
+}
+
+static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+// Parses the game at the start of the buffer. Returns false when the buffer
+// ends before the game does and there is more input to read; a game ends with
+// its result, at the tags of the next game or at the end of the input.
+bool PgnReader::parseGame(PgnGame &game, std::size_t &consumed) {
+  const char *const first = buffer.data() + begin;
+  const char *const last = buffer.data() + end;
+  const char *p = first;
+  auto hasMoves = false;
+
+  auto skipPast = [&p, last](char c) {
+    while (p < last && *p != c) {
+      p++;
+    }
+    if (p >= last) {
+      p = last;
+      return false;
+    }
+    p++;
+    return true;
+  };
+
+  while (p < last) {
+    const auto c = *p;
+    if (isSpace(c)) {
+      p++;
+    } else if (c == '[') {
+      if (hasMoves) {
+        break;
+      }
+      // [Name "Value"], the value may hold \" and \\.
+      p++;
+      while (p < last && isSpace(*p)) {
+        p++;
+      }
+      const auto name = p;
+      while (p < last && !isSpace(*p) && *p != '"' && *p != ']') {
+        p++;
+      }
+      const auto nameEnd = p;
+      while (p < last && *p != '"' && *p != ']') {
+        p++;
+      }
+      auto value = p;
+      auto valueEnd = p;
+      if (p < last && *p == '"') {
+        value = ++p;
+        while (p < last && *p != '"') {
+          p += *p == '\\' ? 2 : 1;
+        }
+        valueEnd = std::min(p, last);
+      }
+      if (!skipPast(']')) {
+        break;
+      }
+      game.tags.emplace_back(std::string_view(name, nameEnd - name),
+                             std::string_view(value, valueEnd - value));
+    } else if (c == '{') {
+      if (!skipPast('}')) {
+        break;
+      }
+    } else if (c == ';' || (c == '%' && (p == first || p[-1] == '\n'))) {
+      if (!skipPast('\n')) {
+        break;
+      }
+    } else if (c == '(') {
+      // Variations nest and may hold comments with parentheses in them.
+      auto depth = 0;
+      do {
+        if (*p == '(') {
+          depth++;
+        } else if (*p == ')') {
+          depth--;
+        } else if (*p == '{') {
+          skipPast('}');
+          continue;
+        } else if (*p == ';') {
+          skipPast('\n');
+          continue;
+        }
+        p++;
+      } while (p < last && depth > 0);
+      if (depth > 0) {
+        break;
+      }
+    } else if (c == '$') {
+      p++;
+      while (p < last && isDigit(*p)) {
+        p++;
+      }
+    } else if (c == ')' || c == ']' || c == '}') {
+      p++;
+    } else {
+      const auto token = p;
+      while (p < last && !isDelimiter(*p)) {
+        p++;
+      }
+      if (p == last && !inputDone) {
+        break;
+      }
+      auto move = std::string_view(token, p - token);
+      hasMoves = true;
+      if (isResult(move)) {
+        game.result = move;
+        consumed = p - buffer.data();
+        return true;
+      }
+      // Move numbers, "12." or "12...", may be written against the move.
+      while (!move.empty() && (isDigit(move[0]) || move[0] == '.')) {
+        move.remove_prefix(1);
+      }
+      if (!move.empty()) {
+        game.moves.push_back(move);
+      }
+    }
+  }
+
+  if (p < last || inputDone) {
+    consumed = p - buffer.data();
+    return true;
+  }
+  return false;
+}
+
+// Done once the game is complete, in the buffer, since an unescaped value is
+// never longer than the escaped one.
+void PgnReader::unescapeTags(PgnGame &game) {
+  for (auto &tag : game.tags) {
+    if (tag.second.find('\\') == std::string_view::npos) {
+      continue;
+    }
+    auto *value = buffer.data() + (tag.second.data() - buffer.data());
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < tag.second.size(); i++) {
+      if (value[i] == '\\' && i + 1 < tag.second.size()) {
+        i++;
+      }
+      value[length++] = value[i];
+    }
+    tag.second = std::string_view(value, length);
+  }
+}
+
+// Keeps the unparsed part of the buffer and reads the next chunk after it,
+// growing the buffer when a game does not fit.
+bool PgnReader::fillBuffer() {
+  if (begin > 0) {
+    std::copy(buffer.data() + begin, buffer.data() + end, buffer.data());
+    end -= begin;
+    begin = 0;
+  }
+  if (end == buffer.size()) {
+    buffer.resize(buffer.size() * 2);
+  }
+  input.read(buffer.data() + end, buffer.size() - end);
+  end += input.gcount();
+  return input.gcount() > 0;
+}
+
+bool PgnReader::readGame(PgnGame &game) {
+  while (true) {
+    game.tags.clear();
+    game.moves.clear();
+    game.result = "";
+
+    std::size_t consumed = begin;
+    if (parseGame(game, consumed)) {
+      begin = consumed;
+      unescapeTags(game);
+      if (game.result.empty()) {
+        game.result = game.getTag("Result");
+      }
+      if (!game.moves.empty() || !game.tags.empty()) {
+        return true;
+      }
+      if (inputDone) {
+        return false;
+      }
+    }
+    if (!inputDone && !fillBuffer()) {
+      inputDone = true;
+    }
+  }
+}
+
+static int letterToPieceIndex(char letter) {
+  switch (letter) {
+  case 'N':
+    return KNIGHT_INDEX;
+  case 'B':
+    return BISHOP_INDEX;
+  case 'R':
+    return ROOK_INDEX;
+  case 'Q':
+    return QUEEN_INDEX;
+  case 'K':
+    return KING_INDEX;
+  }
+  return -1;
+}
+
+static std::string letterToPromotionType(char letter) {
+  switch (letter) {
+  case 'N':
+    return KNIGHT;
+  case 'B':
+    return BISHOP;
+  case 'R':
+    return ROOK;
+  }
+  return QUEEN;
+}
+
+static bool isFile(char c) { return c >= 'a' && c <= 'h'; }
+
+static bool isRank(char c) { return c >= '1' && c <= '8'; }
+
+// Candidates come from the attack tables: a knight, bishop, rook, queen or
+// king that can move to a square is attacked by the same piece standing on
+// it. Only the legality of the remaining candidates is checked.
+Move decodeSan(Board &board, std::string_view san, std::string &promotionType) {
+  const auto noMove = Move(0, 0, 0, 0);
+  promotionType = QUEEN;
+
+  auto text = san;
+  while (!text.empty() && (text.back() == '+' || text.back() == '#' ||
+                           text.back() == '!' || text.back() == '?')) {
+    text.remove_suffix(1);
+  }
+
+  const auto color = colorToIndex(board.getTurn());
+  const auto &bitboards = board.getPieceBitboards();
+  const auto opponent = color == WHITE_INDEX ? BLACK_INDEX : WHITE_INDEX;
+  const int homeRow = color == WHITE_INDEX ? BOARD_LENGTH - 1 : 0;
+
+  if (text == "O-O" || text == "0-0" || text == "O-O-O" || text == "0-0-0") {
+    const auto isShort = text.size() == 3;
+    const auto kingSquare = homeRow * BOARD_LENGTH + 4;
+    const auto rookSquare = homeRow * BOARD_LENGTH + (isShort ? 7 : 0);
+    Bitboard between = 0;
+    for (auto square = std::min(kingSquare, rookSquare) + 1;
+         square < std::max(kingSquare, rookSquare); square++) {
+      between |= bitboard::squareBit(square);
+    }
+    const Move castle(homeRow, 4, homeRow, isShort ? 6 : 2);
+    if ((bitboards.pieces[color][KING_INDEX] &
+         bitboard::squareBit(kingSquare)) == 0 ||
+        (bitboards.pieces[color][ROOK_INDEX] &
+         bitboard::squareBit(rookSquare)) == 0 ||
+        (bitboards.occupied() & between) != 0) {
+      return noMove;
+    }
+    // The king's legal moves know the castling rights and whether the king
+    // is in check or passes through it.
+    const auto kingMoves = board.calcAndGetLegalMoves(homeRow, 4);
+    const auto canCastle = std::any_of(
+        begin(kingMoves), end(kingMoves), [&castle](const Square &square) {
+          return square.getRow() == castle.endRow &&
+                 square.getCol() == castle.endCol;
+        });
+    return canCastle ? castle : noMove;
+  }
+
+  const auto equals = text.find('=');
+  if (equals != std::string::npos && equals + 1 < text.size()) {
+    promotionType = letterToPromotionType(text[equals + 1]);
+    text = text.substr(0, equals);
+  } else if (text.size() > 2 && isFile(text[0]) &&
+             letterToPieceIndex(text.back()) != -1) {
+    promotionType = letterToPromotionType(text.back());
+    text.remove_suffix(1);
+  }
+
+  auto type = PAWN_INDEX;
+  if (!text.empty() && letterToPieceIndex(text[0]) != -1) {
+    type = letterToPieceIndex(text[0]);
+    text.remove_prefix(1);
+  }
+  if (text.size() < 2 || !isFile(text[text.size() - 2]) ||
+      !isRank(text.back())) {
+    return noMove;
+  }
+
+  const int endRow = '8' - text.back();
+  const int endCol = text[text.size() - 2] - 'a';
+  const auto endSquare = endRow * BOARD_LENGTH + endCol;
+  if (bitboards.colors[color] & bitboard::squareBit(endSquare)) {
+    return noMove;
+  }
+
+  int startRow = -1;
+  int startCol = -1;
+  for (std::size_t i = 0; i + 2 < text.size(); i++) {
+    if (isFile(text[i])) {
+      startCol = text[i] - 'a';
+    } else if (isRank(text[i])) {
+      startRow = '8' - text[i];
+    }
+  }
+
+  const auto occupied = bitboards.occupied();
+  const auto ownPieces = bitboards.pieces[color][type];
+  Bitboard candidates = 0;
+  if (type == PAWN_INDEX) {
+    const auto behind = color == WHITE_INDEX ? 1 : -1;
+    const auto oneBack = endSquare + behind * BOARD_LENGTH;
+    const auto twoBack = endSquare + 2 * behind * BOARD_LENGTH;
+    const auto doubleStepRow = color == WHITE_INDEX ? 4 : 3;
+    if (startCol == -1 || startCol == endCol) {
+      if ((occupied & bitboard::squareBit(endSquare)) == 0 && oneBack >= 0 &&
+          oneBack < SQUARE_COUNT) {
+        candidates = ownPieces & bitboard::squareBit(oneBack);
+      }
+      if (candidates == 0 && endRow == doubleStepRow &&
+          (occupied & bitboard::squareBit(endSquare)) == 0 &&
+          (occupied & bitboard::squareBit(oneBack)) == 0) {
+        candidates = ownPieces & bitboard::squareBit(twoBack);
+      }
+    } else if ((startCol == endCol - 1 || startCol == endCol + 1) &&
+               oneBack >= 0 && oneBack < SQUARE_COUNT &&
+               ((bitboards.colors[opponent] &
+                 bitboard::squareBit(endSquare)) != 0 ||
+                board.getEnPassantSquare() == endSquare)) {
+      candidates = ownPieces &
+                   bitboard::squareBit(oneBack - endCol + startCol);
+    }
+  } else {
+    candidates =
+        bitboard::pieceAttacks(color, type, endSquare, occupied) & ownPieces;
+  }
+
+  auto found = noMove;
+  auto foundCount = 0;
+  while (candidates) {
+    const auto square = bitboard::popLowestSquare(candidates);
+    const Move move(square / BOARD_LENGTH, square % BOARD_LENGTH, endRow,
+                    endCol);
+    if ((startRow != -1 && move.startRow != startRow) ||
+        (startCol != -1 && move.startCol != startCol) ||
+        !board.isMoveLegal(move)) {
+      continue;
+    }
+    found = move;
+    foundCount++;
+  }
+  return foundCount == 1 ? found : noMove;
+}
+
+bool playSan(Board &board, std::string_view san) {
+  std::string promotionType;
+  const auto move = decodeSan(board, san, promotionType);
+  if (move == Move(0, 0, 0, 0)) {
+    return false;
+  }
+  board.setPromotionType(promotionType);
+  board.makeSearchMove(move);
+  return true;
+}
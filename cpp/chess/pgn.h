@@ -0,0 +1,57 @@
+#ifndef PGN_H
+#define PGN_H
+#include "board.h"
+#include <istream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// One game of a PGN file: its tags, its moves in standard algebraic notation
+// without move numbers, comments, variations or annotations, and its result.
+// The strings are views into the reader's buffer and are only valid until
+// the next game is read.
+struct PgnGame {
+  std::vector<std::pair<std::string_view, std::string_view>> tags;
+  std::vector<std::string_view> moves;
+  std::string_view result;
+
+  // The value of a tag, empty when the game does not have it.
+  std::string_view getTag(std::string_view name) const;
+};
+
+// Reads the games of a PGN file one after the other. The input is read in
+// large chunks and each game is parsed where it lies in the buffer, so
+// reading allocates nothing per move once the buffers have grown to the
+// size of the largest game.
+class PgnReader {
+private:
+  std::istream &input;
+  std::vector<char> buffer;
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  bool inputDone = false;
+
+  bool parseGame(PgnGame &game, std::size_t &consumed);
+
+  void unescapeTags(PgnGame &game);
+
+  bool fillBuffer();
+
+public:
+  explicit PgnReader(std::istream &input);
+
+  // Returns false when there are no more games.
+  bool readGame(PgnGame &game);
+};
+
+// The move a SAN move such as "Nbd7", "exd5", "e8=Q+" or "O-O" makes on board,
+// or the null move when it is not a legal move there. promotionType is set to
+// the piece a pawn promotes to.
+Move decodeSan(Board &board, std::string_view san, std::string &promotionType);
+
+// Decodes the move and plays it with the search's make move, returns false
+// when it is not a legal move.
+bool playSan(Board &board, std::string_view san);
+
+#endif // PGN_H
@@ -1,24 +1,11 @@
 #include "piece.h"
+#include "helpers.h"
+
 Piece::Piece(std::string t, std::string c) {
   type = t;
   color = c;
-  if (t == PAWN) {
-    value = 10;
-  } else if (t == KNIGHT) {
-    value = 32;
-  } else if (t == BISHOP) {
-    value = 34;
-  } else if (t == ROOK) {
-    value = 50;
-  } else if (t == QUEEN) {
-    value = 90;
-  } else if (t == KING) {
-    // Im not sure if this is needed since my board stops the game before the
-    // king is captured I need to add score if game is won/lost instead
-    value = 1000;
-  } else {
-    value = 0;
-  }
+  const auto typeIndex = pieceTypeToIndex(t);
+  value = typeIndex < 0 ? 0 : PIECE_VALUES[typeIndex];
   hasMoved = false;
 }
 
@@ -1,5 +1,9 @@
 #include "randomizer.h"
 
+Randomizer::Randomizer(unsigned int seed) : engine(seed) {}
+
+void Randomizer::setSeed(unsigned int seed) { engine.seed(seed); }
+
 int Randomizer::generateRandomNumber(int start, int end) {
 
   std::uniform_int_distribution<int> dist{start, end};
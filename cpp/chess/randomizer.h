@@ -9,6 +9,12 @@ private:
   std::mt19937 engine = std::mt19937(time(nullptr));
 
 public:
+  Randomizer() = default;
+  explicit Randomizer(unsigned int seed);
+
+  // Makes the numbers that follow repeat from run to run.
+  void setSeed(unsigned int seed);
+
   int generateRandomNumber(int start, int end);
   std::string generatePlayerColor();
 };
@@ -0,0 +1,220 @@
+#include "sessionManager.h"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - time)
+      .count();
+}
+
+SessionManager::SessionManager(ThreadPool &pool, std::size_t queueLimit,
+                               std::size_t tableSize)
+    : pool(pool), queueLimit(queueLimit), tableSize(tableSize),
+      workerTables(pool.getThreadCount()) {}
+
+SessionManager::~SessionManager() {
+  std::unique_lock<std::mutex> lock(mutex);
+  stopping = true;
+  for (auto &session : sessions) {
+    session.second->closed = true;
+    stopSession(*session.second);
+  }
+  queue.clear();
+  taskDone.wait(lock, [this]() { return activeTasks == 0; });
+}
+
+SessionId SessionManager::createSession() {
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto id = nextId++;
+  sessions[id] = std::make_shared<Session>();
+  return id;
+}
+
+bool SessionManager::closeSession(SessionId id) {
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto found = sessions.find(id);
+  if (found == sessions.end()) {
+    return false;
+  }
+  found->second->closed = true;
+  stopSession(*found->second);
+  queue.erase(std::remove_if(begin(queue), end(queue),
+                             [id](const MoveRequest &request) {
+                               return request.id == id;
+                             }),
+              end(queue));
+  sessions.erase(found);
+  return true;
+}
+
+// Stopping touches the game without taking its lock. That is only safe
+// once the worker has started the search: the worker then holds the lock, so
+// nothing can replace the game's computer, and stopping only sets an atomic
+// flag. Earlier, stopRequested is set instead, and the worker stops the
+// search itself as soon as it has started it.
+void SessionManager::stopSession(Session &session) {
+  session.stopRequested = true;
+  if (session.searching) {
+    session.game.stopSearch();
+  }
+}
+
+std::shared_ptr<SessionManager::Session>
+SessionManager::findSession(SessionId id) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto found = sessions.find(id);
+  return found == sessions.end() ? nullptr : found->second;
+}
+
+// A move requested after the check waits for action, which is short.
+SessionAccess
+SessionManager::withGame(SessionId id,
+                         const std::function<void(Game &)> &action) {
+  std::shared_ptr<Session> session;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = sessions.find(id);
+    if (found == sessions.end()) {
+      return SessionAccess::NO_SESSION;
+    }
+    if (found->second->moveRequested) {
+      return SessionAccess::BUSY;
+    }
+    session = found->second;
+  }
+  std::lock_guard<std::mutex> lock(session->mutex);
+  action(session->game);
+  return SessionAccess::DONE;
+}
+
+bool SessionManager::requestComputerMove(SessionId id,
+                                         MoveCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = sessions.find(id);
+    if (found == sessions.end() || found->second->moveRequested ||
+        stopping) {
+      return false;
+    }
+    if (queue.size() >= queueLimit) {
+      stats.rejected++;
+      return false;
+    }
+    found->second->moveRequested = true;
+    queue.push_back(MoveRequest{id, found->second, callback,
+                                std::chrono::steady_clock::now()});
+    activeTasks++;
+  }
+  pool.submit([this]() { playNextMove(); }, TaskPriority::INTERACTIVE);
+  return true;
+}
+
+bool SessionManager::stopComputerMove(SessionId id) {
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto found = sessions.find(id);
+  if (found == sessions.end() || !found->second->moveRequested) {
+    return false;
+  }
+  const auto waiting = std::find_if(
+      begin(queue), end(queue),
+      [id](const MoveRequest &request) { return request.id == id; });
+  if (waiting != end(queue)) {
+    queue.erase(waiting);
+    found->second->moveRequested = false;
+  } else {
+    stopSession(*found->second);
+  }
+  return true;
+}
+
+SessionStats SessionManager::getStats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto current = stats;
+  current.sessions = sessions.size();
+  current.queueDepth = queue.size();
+  return current;
+}
+
+// Every queued move submits one task, which plays the move that has waited
+// longest. A task finds nothing to play when its move was dropped.
+void SessionManager::playNextMove() {
+  MoveRequest request;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) {
+      activeTasks--;
+      taskDone.notify_all();
+      return;
+    }
+    request = std::move(queue.front());
+    queue.pop_front();
+
+    const auto waited = millisecondsSince(request.requestTime);
+    totalWaitMilliseconds += waited;
+    stats.maxWaitMilliseconds = std::max(stats.maxWaitMilliseconds, waited);
+    stats.running++;
+  }
+  playMove(request);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  activeTasks--;
+  taskDone.notify_all();
+}
+
+// The search runs on this worker, in steps like Game::makeComputerMove. Only
+// this worker uses its table slot, so the slots need no lock.
+void SessionManager::playMove(MoveRequest &request) {
+  auto &session = *request.session;
+  auto &table = workerTables[pool.getWorkerIndex()];
+  if (!table) {
+    table = std::make_shared<TranspositionTable>(tableSize);
+  }
+
+  GameInfo gameInfo;
+  auto move = Move(0, 0, 0, 0);
+  {
+    std::lock_guard<std::mutex> sessionLock(session.mutex);
+    auto &game = session.game;
+    game.setTable(table);
+    const auto turn = game.getTurn();
+
+    // The first step clears any earlier stop and starts the search, so a
+    // stop is only passed on after it.
+    auto ready = game.stepComputerMove(0);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      session.searching = true;
+      if (session.stopRequested) {
+        game.stopSearch();
+      }
+    }
+    while (!ready) {
+      ready = game.stepComputerMove(std::numeric_limits<int>::max());
+    }
+    gameInfo = game.waitComputerMove();
+    if (game.getTurn() != turn) {
+      move = gameInfo.getLastMove();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    session.searching = false;
+    session.stopRequested = false;
+  }
+
+  bool closed;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    session.moveRequested = false;
+    closed = session.closed;
+
+    const auto total = millisecondsSince(request.requestTime);
+    stats.running--;
+    stats.movesPlayed++;
+    totalMilliseconds += total;
+    stats.maxTotalMilliseconds = std::max(stats.maxTotalMilliseconds, total);
+    stats.averageWaitMilliseconds = totalWaitMilliseconds / stats.movesPlayed;
+    stats.averageTotalMilliseconds = totalMilliseconds / stats.movesPlayed;
+  }
+  if (!closed && request.callback) {
+    request.callback(request.id, move, gameInfo);
+  }
+}
@@ -0,0 +1,124 @@
+#ifndef SESSION_MANAGER_H
+#define SESSION_MANAGER_H
+#include "game.h"
+#include "threadPool.h"
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+
+using SessionId = std::uint64_t;
+
+// BUSY when the session's game waits for a computer move or searches one.
+enum class SessionAccess { DONE, NO_SESSION, BUSY };
+
+// move is Move(0, 0, 0, 0) when the computer did not move, because it was
+// not its turn or the game is over.
+using MoveCallback =
+    std::function<void(SessionId, const Move &move, const GameInfo &)>;
+
+// Latencies are in milliseconds: waiting is the time a move spent in the
+// queue, total the time from the request until the move was played.
+// movesPlayed counts the answered requests and the averages cover all of
+// them.
+struct SessionStats {
+  std::size_t sessions = 0;
+  std::size_t queueDepth = 0;
+  std::size_t running = 0;
+  long movesPlayed = 0;
+  long rejected = 0;
+  double averageWaitMilliseconds = 0;
+  double averageTotalMilliseconds = 0;
+  double maxWaitMilliseconds = 0;
+  double maxTotalMilliseconds = 0;
+};
+
+// Hosts many games in one process. Each game lives in a session and the
+// computer moves of all sessions are searched as interactive tasks of a
+// thread pool, ahead of any batch work on it. A session has at most one move
+// waiting or being searched, and waiting moves are taken in the order they
+// were asked for, so one busy session cannot starve the others. When
+// queueLimit moves are waiting, new requests are turned away instead of
+// piling up.
+class SessionManager {
+private:
+  struct Session {
+    std::mutex mutex;
+    Game game;
+    bool moveRequested = false;
+    bool searching = false;
+    bool stopRequested = false;
+    bool closed = false;
+  };
+
+  struct MoveRequest {
+    SessionId id;
+    std::shared_ptr<Session> session;
+    MoveCallback callback;
+    std::chrono::steady_clock::time_point requestTime;
+  };
+
+  ThreadPool &pool;
+  std::size_t queueLimit;
+  std::size_t tableSize;
+  std::vector<std::shared_ptr<TranspositionTable>> workerTables;
+  mutable std::mutex mutex;
+  std::condition_variable taskDone;
+  std::size_t activeTasks = 0;
+  std::unordered_map<SessionId, std::shared_ptr<Session>> sessions;
+  SessionId nextId = 1;
+  std::deque<MoveRequest> queue;
+  bool stopping = false;
+  SessionStats stats;
+  double totalWaitMilliseconds = 0;
+  double totalMilliseconds = 0;
+
+  void stopSession(Session &session);
+
+  std::shared_ptr<Session> findSession(SessionId id) const;
+
+  void playNextMove();
+
+  void playMove(MoveRequest &request);
+
+public:
+  // Games do not have a transposition table of their own. Every worker
+  // searches with one table of tableSize entries for all the games it
+  // plays, so memory grows with the workers and not with the sessions.
+  SessionManager(ThreadPool &pool, std::size_t queueLimit,
+                 std::size_t tableSize = TranspositionTable::DEFAULT_SIZE);
+
+  // Stops the moves being searched and waits for them, waiting moves are
+  // dropped.
+  ~SessionManager();
+
+  SessionManager(const SessionManager &) = delete;
+  SessionManager &operator=(const SessionManager &) = delete;
+
+  SessionId createSession();
+
+  // A move of the session that is still waiting is dropped, one being
+  // searched is stopped and not reported.
+  bool closeSession(SessionId id);
+
+  // Runs action on the session's game, for setting it up and playing the
+  // player's moves. Never waits for a search: while the game waits for a
+  // computer move or searches one, action does not run and the game is
+  // BUSY.
+  SessionAccess withGame(SessionId id,
+                         const std::function<void(Game &)> &action);
+
+  // Queues a computer move for the session. A worker of the pool searches
+  // and plays it and then calls callback, on the worker thread. Returns
+  // false when there is no such session, it already waits for a move or the
+  // queue is full.
+  bool requestComputerMove(SessionId id, MoveCallback callback);
+
+  // Drops the session's move if it is still waiting, without calling its
+  // callback. A move being searched is played at once, the best one found so
+  // far. Returns false when the session has no move to stop.
+  bool stopComputerMove(SessionId id);
+
+  SessionStats getStats() const;
+};
+
+#endif // SESSION_MANAGER_H
@@ -0,0 +1,121 @@
+#include "simd.h"
+
+#if defined(SIMD_WASM128)
+#include <wasm_simd128.h>
+#elif defined(SIMD_SSE2)
+#include <immintrin.h>
+#endif
+
+namespace simd {
+
+namespace scalar {
+int maskedSum(Bitboard bits, const int16_t *table) {
+  int sum = 0;
+  for (int i = 0; i < SQUARE_COUNT; i++) {
+    if ((bits >> i) & 1) {
+      sum += table[i];
+    }
+  }
+  return sum;
+}
+} // namespace scalar
+
+#if defined(SIMD_WASM128)
+namespace wasm128 {
+int maskedSum(Bitboard bits, const int16_t *table) {
+  const v128_t laneBits = wasm_i16x8_make(1, 2, 4, 8, 16, 32, 64, 128);
+  v128_t sum = wasm_i16x8_splat(0);
+
+  for (int i = 0; i < SQUARE_COUNT; i += 8) {
+    const v128_t byte = wasm_i16x8_splat(static_cast<int16_t>((bits >> i) & 0xFF));
+    const v128_t mask = wasm_i16x8_eq(wasm_v128_and(byte, laneBits), laneBits);
+    const v128_t values = wasm_v128_load(table + i);
+    sum = wasm_i16x8_add(sum, wasm_v128_and(mask, values));
+  }
+
+  const v128_t wide = wasm_i32x4_dot_i16x8(sum, wasm_i16x8_splat(1));
+  return wasm_i32x4_extract_lane(wide, 0) + wasm_i32x4_extract_lane(wide, 1) +
+         wasm_i32x4_extract_lane(wide, 2) + wasm_i32x4_extract_lane(wide, 3);
+}
+} // namespace wasm128
+#endif
+
+#if defined(SIMD_SSE2)
+namespace sse2 {
+int maskedSum(Bitboard bits, const int16_t *table) {
+  const __m128i laneBits = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+  __m128i sum = _mm_setzero_si128();
+
+  for (int i = 0; i < SQUARE_COUNT; i += 8) {
+    const __m128i byte =
+        _mm_set1_epi16(static_cast<int16_t>((bits >> i) & 0xFF));
+    const __m128i mask =
+        _mm_cmpeq_epi16(_mm_and_si128(byte, laneBits), laneBits);
+    const __m128i values =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(table + i));
+    sum = _mm_add_epi16(sum, _mm_and_si128(mask, values));
+  }
+
+  __m128i wide = _mm_madd_epi16(sum, _mm_set1_epi16(1));
+  wide = _mm_add_epi32(wide, _mm_shuffle_epi32(wide, _MM_SHUFFLE(1, 0, 3, 2)));
+  wide = _mm_add_epi32(wide, _mm_shuffle_epi32(wide, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(wide);
+}
+} // namespace sse2
+#endif
+
+#if defined(SIMD_AVX2)
+namespace avx2 {
+bool isSupported() { return __builtin_cpu_supports("avx2"); }
+
+__attribute__((target("avx2"))) int maskedSum(Bitboard bits,
+                                              const int16_t *table) {
+  const __m256i laneBits =
+      _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048,
+                        4096, 8192, 16384, static_cast<int16_t>(32768));
+  __m256i sum = _mm256_setzero_si256();
+
+  for (int i = 0; i < SQUARE_COUNT; i += 16) {
+    const __m256i word =
+        _mm256_set1_epi16(static_cast<int16_t>((bits >> i) & 0xFFFF));
+    const __m256i mask =
+        _mm256_cmpeq_epi16(_mm256_and_si256(word, laneBits), laneBits);
+    const __m256i values =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(table + i));
+    sum = _mm256_add_epi16(sum, _mm256_and_si256(mask, values));
+  }
+
+  const __m256i wide = _mm256_madd_epi16(sum, _mm256_set1_epi16(1));
+  __m128i half = _mm_add_epi32(_mm256_castsi256_si128(wide),
+                               _mm256_extracti128_si256(wide, 1));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+  half = _mm_add_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(half);
+}
+} // namespace avx2
+#endif
+
+using MaskedSum = int (*)(Bitboard, const int16_t *);
+
+static MaskedSum selectMaskedSum() {
+#if defined(SIMD_AVX2)
+  if (avx2::isSupported()) {
+    return avx2::maskedSum;
+  }
+#endif
+#if defined(SIMD_WASM128)
+  return wasm128::maskedSum;
+#elif defined(SIMD_SSE2)
+  return sse2::maskedSum;
+#else
+  return scalar::maskedSum;
+#endif
+}
+
+static const MaskedSum maskedSumImplementation = selectMaskedSum();
+
+int maskedSum(Bitboard bits, const int16_t *table) {
+  return maskedSumImplementation(bits, table);
+}
+
+} // namespace simd
@@ -0,0 +1,54 @@
+#ifndef SIMD_H
+#define SIMD_H
+#include "constants.h"
+#include <cstdint>
+
+// Vector kernels for the evaluation. Every kernel has a scalar version that
+// defines the expected result; the vector versions must match it bit for bit.
+//
+// Native x86 builds always have SSE2 and pick AVX2 at runtime when the cpu
+// supports it. The web build gets the wasm SIMD128 version when compiled with
+// -msimd128.
+
+#if defined(__wasm_simd128__)
+#define SIMD_WASM128
+#elif defined(__SSE2__)
+#define SIMD_SSE2
+#if defined(__GNUC__)
+#define SIMD_AVX2
+#endif
+#endif
+
+namespace simd {
+
+// Sums table[i] for every bit i set in bits. The table holds one value per
+// square and its entries must stay within +-4095 so that the 16 bit lanes of
+// the vector versions cannot overflow.
+int maskedSum(Bitboard bits, const int16_t *table);
+
+namespace scalar {
+int maskedSum(Bitboard bits, const int16_t *table);
+}
+
+#if defined(SIMD_WASM128)
+namespace wasm128 {
+int maskedSum(Bitboard bits, const int16_t *table);
+}
+#endif
+
+#if defined(SIMD_SSE2)
+namespace sse2 {
+int maskedSum(Bitboard bits, const int16_t *table);
+}
+#endif
+
+#if defined(SIMD_AVX2)
+namespace avx2 {
+bool isSupported();
+int maskedSum(Bitboard bits, const int16_t *table);
+} // namespace avx2
+#endif
+
+} // namespace simd
+
+#endif // SIMD_H
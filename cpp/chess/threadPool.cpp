@@ -0,0 +1,94 @@
+#include "threadPool.h"
+
+static thread_local const ThreadPool *currentPool = nullptr;
+static thread_local int currentIndex = -1;
+
+ThreadPool::ThreadPool(int threadCount) {
+  const auto count = static_cast<std::size_t>(std::max(threadCount, 1));
+  for (std::size_t i = 0; i < count; i++) {
+    queues.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (std::size_t i = 0; i < count; i++) {
+    workers.emplace_back(&ThreadPool::work, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  taskAdded.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+// A task submitted by a worker goes to its own deque, others are spread
+// over the workers in turn.
+void ThreadPool::submit(Task task, TaskPriority priority) {
+  const auto workerIndex = getWorkerIndex();
+  const auto index = workerIndex >= 0 ? static_cast<std::size_t>(workerIndex)
+                                      : nextQueue++ % queues.size();
+  pendingTasks++;
+  {
+    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+    queues[index]->tasks[static_cast<int>(priority)].push_back(
+        std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+  }
+  taskAdded.notify_one();
+}
+
+int ThreadPool::getThreadCount() const {
+  return static_cast<int>(workers.size());
+}
+
+int ThreadPool::getWorkerIndex() const {
+  return currentPool == this ? currentIndex : -1;
+}
+
+// Looks through every deque for an interactive task before it looks for a
+// batch task.
+bool ThreadPool::takeTask(std::size_t index, Task &task) {
+  for (int priority = 0; priority < TASK_PRIORITY_COUNT; priority++) {
+    for (std::size_t i = 0; i < queues.size(); i++) {
+      auto &queue = *queues[(index + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      auto &tasks = queue.tasks[priority];
+      if (tasks.empty()) {
+        continue;
+      }
+      if (i == 0) {
+        task = std::move(tasks.back());
+        tasks.pop_back();
+      } else {
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      pendingTasks--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::work(std::size_t index) {
+  currentPool = this;
+  currentIndex = static_cast<int>(index);
+  while (true) {
+    Task task;
+    if (takeTask(index, task)) {
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    taskAdded.wait(lock,
+                   [this]() { return pendingTasks > 0 || stopping; });
+    if (stopping && pendingTasks == 0) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,64 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Interactive tasks, such as a move a player waits for, are taken before
+// batch tasks. A batch task that already runs is not interrupted.
+enum class TaskPriority { INTERACTIVE, BATCH };
+
+constexpr int TASK_PRIORITY_COUNT = 2;
+
+using Task = std::function<void()>;
+
+// A fixed number of worker threads shared by everything the engine runs in
+// parallel. Every worker has its own deques of tasks, one per priority. A
+// worker takes the newest task of its own deque, so tasks it submits itself
+// run while their data is still in its cache, and when it has nothing left
+// it steals the oldest task of another worker.
+class ThreadPool {
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks[TASK_PRIORITY_COUNT];
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::vector<std::thread> workers;
+  std::atomic<std::size_t> pendingTasks{0};
+  std::atomic<std::size_t> nextQueue{0};
+  std::mutex sleepMutex;
+  std::condition_variable taskAdded;
+  bool stopping = false;
+
+  bool takeTask(std::size_t index, Task &task);
+
+  void work(std::size_t index);
+
+public:
+  explicit ThreadPool(
+      int threadCount = std::max(1u, std::thread::hardware_concurrency()));
+
+  // Runs the tasks that are still waiting, then stops the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // Safe to call from any thread, also from a running task.
+  void submit(Task task, TaskPriority priority = TaskPriority::BATCH);
+
+  int getThreadCount() const;
+
+  // The index of the calling thread among the workers, -1 when it is not
+  // one of them.
+  int getWorkerIndex() const;
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,75 @@
+#include "timeManager.h"
+#include <algorithm>
+
+TimeManager::TimeManager(std::chrono::milliseconds softLimit,
+                         std::chrono::milliseconds hardLimit)
+    : baseSoftLimit(softLimit), softLimit(softLimit), hardLimit(hardLimit) {}
+
+// Aims for an even share of the remaining time plus the increment, and never
+// allows a single move to use more than half of what is left.
+TimeManager TimeManager::fromClock(const GameClock &clock) {
+  const auto movesToGo =
+      clock.movesToGo > 0 ? clock.movesToGo : DEFAULT_MOVES_TO_GO;
+  const auto remaining = std::max(std::chrono::milliseconds(0),
+                                  clock.remaining - MOVE_OVERHEAD);
+
+  const auto target = remaining / movesToGo + clock.increment;
+  const auto hardLimit = std::min(target * 3, remaining / 2);
+  return TimeManager(std::min(target, hardLimit), hardLimit);
+}
+
+void TimeManager::start() {
+  startTime = std::chrono::steady_clock::now();
+  stopped = false;
+  softLimit = baseSoftLimit;
+  completedIterations = 0;
+  stableIterations = 0;
+  scoreDropped = false;
+}
+
+bool TimeManager::canStartIteration() const {
+  return !stopped && getElapsed() < softLimit;
+}
+
+bool TimeManager::shouldAbort(long nodes) {
+  if (!stopped && nodes % CHECK_INTERVAL == 0) {
+    stopped = getElapsed() >= hardLimit;
+  }
+  return stopped;
+}
+
+void TimeManager::completeIteration(bool bestMoveChanged, int score) {
+  stableIterations = bestMoveChanged ? 0 : stableIterations + 1;
+  if (completedIterations > 0 && score <= previousScore - SCORE_DROP) {
+    scoreDropped = true;
+  }
+  previousScore = score;
+  completedIterations++;
+
+  auto scale = 1.0;
+  if (stableIterations >= 4) {
+    scale = 0.4;
+  } else if (stableIterations >= 2) {
+    scale = 0.7;
+  }
+  if (scoreDropped) {
+    scale *= 2;
+  }
+
+  const auto scaled = std::chrono::milliseconds(
+      static_cast<long long>(baseSoftLimit.count() * scale));
+  softLimit = std::min(scaled, hardLimit);
+}
+
+std::chrono::milliseconds TimeManager::getElapsed() const {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - startTime);
+}
+
+std::chrono::milliseconds TimeManager::getSoftLimit() const {
+  return softLimit;
+}
+
+std::chrono::milliseconds TimeManager::getHardLimit() const {
+  return hardLimit;
+}
@@ -0,0 +1,57 @@
+#ifndef TIME_MANAGER_H
+#define TIME_MANAGER_H
+#include <chrono>
+
+// The computer's clock in a timed game. A movesToGo of 0 means sudden death.
+struct GameClock {
+  std::chrono::milliseconds remaining{0};
+  std::chrono::milliseconds increment{0};
+  int movesToGo = 0;
+};
+
+// Decides when the search has to stop. No new iteration is started once the
+// soft limit has passed, and the search is aborted wherever it is when the
+// hard limit passes. The clock is only read every CHECK_INTERVAL nodes.
+//
+// The soft limit shrinks while the best move stays the same between
+// iterations and grows, up to the hard limit, when the score drops.
+class TimeManager {
+private:
+  std::chrono::steady_clock::time_point startTime;
+  std::chrono::milliseconds baseSoftLimit{0};
+  std::chrono::milliseconds softLimit{0};
+  std::chrono::milliseconds hardLimit{0};
+  bool stopped = false;
+  int completedIterations = 0;
+  int stableIterations = 0;
+  int previousScore = 0;
+  bool scoreDropped = false;
+
+public:
+  static constexpr long CHECK_INTERVAL = 256;
+  static constexpr int DEFAULT_MOVES_TO_GO = 30;
+  static constexpr int SCORE_DROP = 20;
+  static constexpr std::chrono::milliseconds MOVE_OVERHEAD{20};
+
+  TimeManager() = default;
+  TimeManager(std::chrono::milliseconds softLimit,
+              std::chrono::milliseconds hardLimit);
+
+  static TimeManager fromClock(const GameClock &clock);
+
+  void start();
+
+  bool canStartIteration() const;
+
+  bool shouldAbort(long nodes);
+
+  void completeIteration(bool bestMoveChanged, int score);
+
+  std::chrono::milliseconds getElapsed() const;
+
+  std::chrono::milliseconds getSoftLimit() const;
+
+  std::chrono::milliseconds getHardLimit() const;
+};
+
+#endif // TIME_MANAGER_H
@@ -0,0 +1,54 @@
+#include "transpositionTable.h"
+#include "helpers.h"
+
+Move TableEntry::getMove() const {
+  return Move(from / BOARD_LENGTH, from % BOARD_LENGTH, to / BOARD_LENGTH,
+              to % BOARD_LENGTH);
+}
+
+TranspositionTable::TranspositionTable(std::size_t size) : slots(size) {}
+
+// score, from, to, depth and bound, low bits first.
+static std::uint64_t pack(int score, int from, int to, int depth, Bound bound) {
+  return static_cast<std::uint32_t>(score) |
+         static_cast<std::uint64_t>(from) << 32 |
+         static_cast<std::uint64_t>(to) << 40 |
+         static_cast<std::uint64_t>(static_cast<std::uint8_t>(depth)) << 48 |
+         static_cast<std::uint64_t>(bound) << 56;
+}
+
+std::optional<TableEntry>
+TranspositionTable::probe(std::uint64_t key) const {
+  const auto &slot = slots[key & (slots.size() - 1)];
+  const auto data = slot.data.load(std::memory_order_relaxed);
+  const auto check = slot.check.load(std::memory_order_relaxed);
+  if (data == 0 || (check ^ data) != key) {
+    return std::nullopt;
+  }
+
+  TableEntry entry;
+  entry.key = key;
+  entry.score = static_cast<std::int32_t>(data & 0xffffffff);
+  entry.from = data >> 32 & 0xff;
+  entry.to = data >> 40 & 0xff;
+  entry.depth = static_cast<std::int8_t>(data >> 48 & 0xff);
+  entry.bound = static_cast<Bound>(data >> 56 & 0xff);
+  return entry;
+}
+
+void TranspositionTable::store(std::uint64_t key, int depth, int score,
+                               Bound bound, const Move &move) {
+  auto &slot = slots[key & (slots.size() - 1)];
+  const auto data =
+      pack(score, toSquareIndex(move.startRow, move.startCol),
+           toSquareIndex(move.endRow, move.endCol), depth, bound);
+  slot.data.store(data, std::memory_order_relaxed);
+  slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+  for (auto &slot : slots) {
+    slot.data.store(0, std::memory_order_relaxed);
+    slot.check.store(0, std::memory_order_relaxed);
+  }
+}
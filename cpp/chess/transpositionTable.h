@@ -0,0 +1,57 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+#include "move.h"
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+enum class Bound : std::uint8_t { NONE, EXACT, LOWER, UPPER };
+
+// What the search learned about a position. The score is exact, or only a
+// lower or an upper bound when the search of the position was cut off.
+struct TableEntry {
+  std::uint64_t key = 0;
+  std::int32_t score = 0;
+  std::uint8_t from = 0;
+  std::uint8_t to = 0;
+  std::int8_t depth = 0;
+  Bound bound = Bound::NONE;
+
+  Move getMove() const;
+};
+
+// Remembers searched positions by their zobrist hash, so a position reached
+// again, by another move order or in a later search, is not searched again
+// and its best move is tried first. Fixed size, a new entry always replaces
+// the one in its slot.
+//
+// Several searches may share a table from different threads. A slot holds
+// the entry packed into one word and the key xor that word, so an entry torn
+// by two threads writing the slot at once no longer matches its key and is
+// read as a miss.
+class TranspositionTable {
+private:
+  struct Slot {
+    std::atomic<std::uint64_t> check{0};
+    std::atomic<std::uint64_t> data{0};
+  };
+
+  std::vector<Slot> slots;
+
+public:
+  static constexpr std::size_t DEFAULT_SIZE = std::size_t(1) << 19;
+
+  // size must be a power of two.
+  explicit TranspositionTable(std::size_t size = DEFAULT_SIZE);
+
+  // Empty when the position is not in the table.
+  std::optional<TableEntry> probe(std::uint64_t key) const;
+
+  void store(std::uint64_t key, int depth, int score, Bound bound,
+             const Move &move);
+
+  void clear();
+};
+
+#endif // TRANSPOSITION_TABLE_H
@@ -0,0 +1,49 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+#include "constants.h"
+
+// Random keys for hashing a position. A position's hash is the xor of the
+// keys of every piece on its square, plus the side key when black is to move,
+// so making a move only needs a few xors.
+namespace zobrist {
+
+// The keys come from a fixed seed and are computed by the compiler, so hashes
+// are identical between runs and builds and can be worked out at compile
+// time, see the built-in opening book.
+struct Keys {
+  std::uint64_t pieces[COLOR_COUNT][PIECE_TYPE_COUNT][SQUARE_COUNT] = {};
+  std::uint64_t side = 0;
+
+  constexpr Keys() {
+    std::uint64_t state = 0x5eed5eed;
+    for (auto &color : pieces) {
+      for (auto &type : color) {
+        for (auto &square : type) {
+          square = next(state);
+        }
+      }
+    }
+    side = next(state);
+  }
+
+  // splitmix64
+  static constexpr std::uint64_t next(std::uint64_t &state) {
+    state += 0x9e3779b97f4a7c15ULL;
+    auto z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+};
+
+inline constexpr Keys keys;
+
+constexpr std::uint64_t pieceKey(int color, int type, int square) {
+  return keys.pieces[color][type][square];
+}
+
+constexpr std::uint64_t sideKey() { return keys.side; }
+
+} // namespace zobrist
+
+#endif // ZOBRIST_H
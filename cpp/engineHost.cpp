@@ -0,0 +1,162 @@
+#include "chess/helpers.h"
+#include "chess/sessionManager.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Serves many games from one process over a line protocol on standard input
+// and output. Computer moves are searched by a thread pool, see
+// SessionManager, and reported when they are played, so answers for
+// different sessions may come in any order. A command for a session that
+// waits for a computer move is answered with busy <id> at once, it never
+// holds up the other sessions.
+//
+//   new [white|black] [timePerMove] [strengthLevel]  -> session <id>
+//   move <id> e2e4                                    -> played <id> <status>
+//   go <id>                                           -> queued <id>, later
+//                                                        bestmove <id> <move>
+//   stop <id>                                         -> stopped <id>
+//   close <id>                                        -> closed <id>
+//   stats                                             -> stats ...
+//   quit
+//
+// Usage: engineHost [--workers N] [--queue N]
+
+std::mutex outputMutex;
+
+void reply(const std::string &line) {
+  std::lock_guard<std::mutex> lock(outputMutex);
+  std::cout << line << std::endl;
+}
+
+std::string withStatus(std::string line, const std::string &status) {
+  return status.empty() ? line : line + " " + status;
+}
+
+std::string promotionType(char letter) {
+  switch (letter) {
+  case 'n':
+    return KNIGHT;
+  case 'b':
+    return BISHOP;
+  case 'r':
+    return ROOK;
+  }
+  return QUEEN;
+}
+
+bool isSquare(const std::string &text, std::size_t at) {
+  return text.size() >= at + 2 && text[at] >= 'a' && text[at] <= 'h' &&
+         text[at + 1] >= '1' && text[at + 1] <= '8';
+}
+
+void playMove(SessionManager &manager, SessionId id, const std::string &move) {
+  if (!isSquare(move, 0) || !isSquare(move, 2)) {
+    reply("error " + std::to_string(id) + " bad move " + move);
+    return;
+  }
+  const auto converted = stringToMoves(move.substr(0, 4)).front();
+
+  std::string status;
+  const auto access = manager.withGame(id, [&](Game &game) {
+    const auto turn = game.getTurn();
+    game.setPromotionType(promotionType(move.size() > 4 ? move[4] : 'q'));
+    game.calcAndGetLegalMoves(converted.startRow, converted.startCol);
+    const auto gameInfo =
+        game.makeAMove(converted.startRow, converted.startCol,
+                       converted.endRow, converted.endCol);
+    status = game.getTurn() == turn ? "illegal" : gameInfo.getStatus();
+  });
+  if (access == SessionAccess::NO_SESSION) {
+    reply("error " + std::to_string(id) + " no such session");
+  } else if (access == SessionAccess::BUSY) {
+    reply("busy " + std::to_string(id));
+  } else if (status == "illegal") {
+    reply("illegal " + std::to_string(id) + " " + move);
+  } else {
+    reply(withStatus("played " + std::to_string(id), status));
+  }
+}
+
+// Holds the output until the request is answered, so that "queued" is
+// printed before the move.
+void requestMove(SessionManager &manager, SessionId id) {
+  std::lock_guard<std::mutex> lock(outputMutex);
+  const auto queued = manager.requestComputerMove(
+      id, [](SessionId id, const Move &move, const GameInfo &gameInfo) {
+        const auto played =
+            move == Move(0, 0, 0, 0) ? "none" : moveToCoordinates(move);
+        reply(withStatus("bestmove " + std::to_string(id) + " " + played,
+                         gameInfo.getStatus()));
+      });
+  std::cout << (queued ? "queued " : "busy ") << id << std::endl;
+}
+
+void printStats(const SessionManager &manager) {
+  const auto stats = manager.getStats();
+  std::ostringstream line;
+  line << "stats sessions " << stats.sessions << " queue " << stats.queueDepth
+       << " running " << stats.running << " played " << stats.movesPlayed
+       << " rejected " << stats.rejected << " wait "
+       << stats.averageWaitMilliseconds << "/" << stats.maxWaitMilliseconds
+       << " total " << stats.averageTotalMilliseconds << "/"
+       << stats.maxTotalMilliseconds;
+  reply(line.str());
+}
+
+int main(int argc, char *argv[]) {
+  int workers = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t queueLimit = 256;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string argument = argv[i];
+    if (argument == "--workers") {
+      workers = std::max(1, std::stoi(argv[i + 1]));
+    } else if (argument == "--queue") {
+      queueLimit = std::stoul(argv[i + 1]);
+    }
+  }
+
+  ThreadPool pool(workers);
+  SessionManager manager(pool, queueLimit);
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    std::istringstream words(line);
+    std::string command;
+    SessionId id = 0;
+    words >> command;
+
+    if (command == "new") {
+      std::string color = WHITE;
+      int timePerMove = 1000;
+      int strengthLevel = 0;
+      std::string word;
+      if (words >> word) {
+        color = word == "black" ? BLACK : WHITE;
+      }
+      words >> timePerMove >> strengthLevel;
+      id = manager.createSession();
+      manager.withGame(id, [&](Game &game) {
+        game.newGame(color, timePerMove, true, strengthLevel);
+      });
+      reply("session " + std::to_string(id));
+    } else if (command == "move" && words >> id) {
+      std::string move;
+      words >> move;
+      playMove(manager, id, move);
+    } else if (command == "go" && words >> id) {
+      requestMove(manager, id);
+    } else if (command == "stop" && words >> id) {
+      reply((manager.stopComputerMove(id) ? "stopped " : "error no move ") +
+            std::to_string(id));
+    } else if (command == "close" && words >> id) {
+      reply((manager.closeSession(id) ? "closed " : "error no session ") +
+            std::to_string(id));
+    } else if (command == "stats") {
+      printStats(manager);
+    } else if (command == "quit") {
+      break;
+    } else if (!command.empty()) {
+      reply("error unknown command " + line);
+    }
+  }
+}
@@ -31,6 +31,39 @@ EMSCRIPTEN_BINDINGS(my_module) {
       .property("endRow", &Move::endRow)
       .property("endCol", &Move::endCol);
 
+  emscripten::class_<SearchProgress>("SearchProgress")
+      .property("depth", &SearchProgress::depth)
+      .property("nodes", &SearchProgress::nodes)
+      .property("score", &SearchProgress::score)
+      .property("bestMove", &SearchProgress::bestMove);
+
+  emscripten::class_<AnalysisLine>("AnalysisLine")
+      .property("moves", &AnalysisLine::moves)
+      .property("depth", &AnalysisLine::depth)
+      .property("centipawns", &AnalysisLine::centipawns)
+      .property("mateIn", &AnalysisLine::mateIn);
+
+  emscripten::class_<IterationStats>("IterationStats")
+      .property("depth", &IterationStats::depth)
+      .property("nodes", &IterationStats::nodes)
+      .property("milliseconds", &IterationStats::milliseconds)
+      .property("score", &IterationStats::score);
+
+  emscripten::class_<SearchStats>("SearchStats")
+      .property("depth", &SearchStats::depth)
+      .property("nodes", &SearchStats::nodes)
+      .property("milliseconds", &SearchStats::milliseconds)
+      .property("nodesPerSecond", &SearchStats::nodesPerSecond)
+      .property("effectiveBranchingFactor",
+                &SearchStats::effectiveBranchingFactor)
+      .property("tableProbes", &SearchStats::tableProbes)
+      .property("tableHits", &SearchStats::tableHits)
+      .property("tableHitRate", &SearchStats::tableHitRate)
+      .property("cutoffs", &SearchStats::cutoffs)
+      .property("firstMoveCutoffs", &SearchStats::firstMoveCutoffs)
+      .property("firstMoveCutoffRate", &SearchStats::firstMoveCutoffRate)
+      .property("iterations", &SearchStats::iterations);
+
   emscripten::class_<Board>("BoardPtr")
       .constructor<>()
       .smart_ptr<std::shared_ptr<Board>>("BoardPtr")
@@ -45,9 +78,27 @@ EMSCRIPTEN_BINDINGS(my_module) {
       .function("calcAndGetLegalMoves", &Game::calcAndGetLegalMoves)
       .function("getSquares", &Game::getSquares)
       .function("newGame", &Game::newGame)
-      .function("makeComputerMove", &Game::makeComputerMove);
+      .function("setComputerClock", &Game::setComputerClock)
+      .function("makeComputerMove", &Game::makeComputerMove)
+      .function("startComputerMove", &Game::startComputerMove)
+      .function("stepComputerMove", &Game::stepComputerMove)
+      .function("isComputerMoveReady", &Game::isComputerMoveReady)
+      .function("waitComputerMove", &Game::waitComputerMove)
+      .function("getSearchProgress", &Game::getSearchProgress)
+      .function("getSearchStats", &Game::getSearchStats)
+      .function("setMultiPv", &Game::setMultiPv)
+      .function("getAnalysisLines", &Game::getAnalysisLines)
+      .function("stopSearch", &Game::stopSearch)
+      .function("setPondering", &Game::setPondering)
+      .function("setSeed", &Game::setSeed)
+      .function("loadOpeningBook", &Game::loadOpeningBook)
+      .function("setBestBookMoves", &Game::setBestBookMoves)
+      .function("getPonderMove", &Game::getPonderMove);
 
   emscripten::register_vector<Piece>("pieceVector");
+  emscripten::register_vector<IterationStats>("iterationStatsVector");
+  emscripten::register_vector<Move>("moveVector");
+  emscripten::register_vector<AnalysisLine>("analysisLineVector");
   emscripten::register_vector<Square>("squareVector");
   emscripten::register_vector<std::vector<Square>>("2dVector");
 
@@ -0,0 +1,300 @@
+#include "chess/bookFile.h"
+#include "chess/pgn.h"
+#include "chess/threadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Compiles PGN files into a binary opening book, see BookFile. The files are
+// cut into chunks of whole games that the workers of a thread pool read in
+// parallel, so one large file is spread over all of them. Every position of
+// the first plies of a game is counted together with the move played and the
+// game's result, and moves played in fewer than min-games games are left out.
+//
+// Usage: makeBook [--plies N] [--min-games N] [--threads N] book.bin a.pgn ...
+
+struct PositionMove {
+  std::uint64_t key;
+  std::uint16_t move;
+
+  bool operator==(const PositionMove &other) const {
+    return key == other.key && move == other.move;
+  }
+};
+
+struct PositionMoveHash {
+  std::size_t operator()(const PositionMove &positionMove) const {
+    return positionMove.key ^ (positionMove.move * 0x9e3779b97f4a7c15ULL);
+  }
+};
+
+// From the point of view of the side making the move.
+struct MoveResults {
+  std::uint64_t wins = 0;
+  std::uint64_t draws = 0;
+  std::uint64_t losses = 0;
+};
+
+using MoveCounts =
+    std::unordered_map<PositionMove, MoveResults, PositionMoveHash>;
+
+struct Options {
+  int plies = 20;
+  int minGames = 2;
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  std::string output;
+  std::vector<std::string> inputs;
+};
+
+// Games set up from a FEN tag are replayed from that position, and skipped
+// when the tag does not parse.
+void countGame(const PgnGame &game, int plies, MoveCounts &counts) {
+  const auto &result = game.result;
+  if (result != "1-0" && result != "0-1" && result != "1/2-1/2") {
+    return;
+  }
+
+  auto start = std::make_shared<Board>();
+  const auto fen = game.getTag("FEN");
+  if (!fen.empty()) {
+    start = Board::fromFEN(fen);
+    if (!start) {
+      return;
+    }
+  }
+  auto &board = *start;
+  for (int ply = 0; ply < plies && ply < static_cast<int>(game.moves.size());
+       ply++) {
+    std::string promotionType;
+    const auto move = decodeSan(board, game.moves[ply], promotionType);
+    if (move == Move(0, 0, 0, 0)) {
+      return;
+    }
+
+    auto &results =
+        counts[PositionMove{board.getHash(), BookEntry::encodeMove(move)}];
+    const auto whiteMoves = board.getTurn() == WHITE;
+    if (result == "1/2-1/2") {
+      results.draws++;
+    } else if ((result == "1-0") == whiteMoves) {
+      results.wins++;
+    } else {
+      results.losses++;
+    }
+
+    board.setPromotionType(promotionType);
+    board.makeSearchMove(move);
+  }
+}
+
+void countGames(const std::string &chunk, int plies, MoveCounts &counts,
+                long &games) {
+  std::istringstream input(chunk);
+  PgnReader reader(input);
+  PgnGame game;
+  while (reader.readGame(game)) {
+    countGame(game, plies, counts);
+    games++;
+  }
+}
+
+constexpr std::size_t CHUNK_SIZE = std::size_t(4) << 20;
+
+// Where the last game of text starts: a tag line after an empty line, with
+// either line ending. npos when text holds no such line past its start.
+std::size_t findLastGameStart(const std::string &text) {
+  auto position = text.rfind("\n[");
+  while (position != std::string::npos && position > 0) {
+    if (text[position - 1] == '\n' ||
+        (position > 1 && text[position - 1] == '\r' &&
+         text[position - 2] == '\n')) {
+      return position + 1;
+    }
+    position = text.rfind("\n[", position - 1);
+  }
+  return std::string::npos;
+}
+
+// Reads the file in blocks and hands on everything before the last game
+// that starts in what has been read so far.
+bool splitFile(const std::string &path,
+               const std::function<void(std::string)> &submit) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::cerr << "Could not open " << path << std::endl;
+    return false;
+  }
+  std::string pending;
+  std::vector<char> block(CHUNK_SIZE);
+  while (file) {
+    file.read(block.data(), block.size());
+    pending.append(block.data(), file.gcount());
+    const auto cut = findLastGameStart(pending);
+    if (cut != std::string::npos) {
+      submit(pending.substr(0, cut));
+      pending.erase(0, cut);
+    }
+  }
+  if (file.bad()) {
+    std::cerr << "Could not read " << path << std::endl;
+    return false;
+  }
+  if (!pending.empty()) {
+    submit(std::move(pending));
+  }
+  return true;
+}
+
+std::uint32_t saturate(std::uint64_t count) {
+  return static_cast<std::uint32_t>(std::min<std::uint64_t>(count, UINT32_MAX));
+}
+
+// A move weighs two for every win and one for every draw, scaled so that the
+// heaviest move of each position fits the entry.
+std::vector<BookEntry> makeEntries(const MoveCounts &counts, int minGames) {
+  std::vector<std::pair<PositionMove, MoveResults>> moves;
+  for (const auto &count : counts) {
+    const auto &results = count.second;
+    if (results.wins + results.draws + results.losses >=
+        static_cast<std::uint64_t>(minGames)) {
+      moves.push_back(count);
+    }
+  }
+  std::sort(begin(moves), end(moves), [](const auto &a, const auto &b) {
+    return a.first.key < b.first.key ||
+           (a.first.key == b.first.key && a.first.move < b.first.move);
+  });
+
+  std::vector<BookEntry> entries;
+  for (std::size_t first = 0; first < moves.size();) {
+    auto last = first;
+    std::uint64_t heaviest = 0;
+    while (last < moves.size() &&
+           moves[last].first.key == moves[first].first.key) {
+      const auto &results = moves[last].second;
+      heaviest = std::max(heaviest, 2 * results.wins + results.draws);
+      last++;
+    }
+
+    for (auto i = first; i < last; i++) {
+      const auto &results = moves[i].second;
+      auto weight = 2 * results.wins + results.draws;
+      if (heaviest > UINT16_MAX) {
+        weight = weight * UINT16_MAX / heaviest;
+      }
+
+      BookEntry entry;
+      entry.key = moves[i].first.key;
+      entry.move = moves[i].first.move;
+      entry.weight = static_cast<std::uint16_t>(weight);
+      entry.wins = saturate(results.wins);
+      entry.draws = saturate(results.draws);
+      entry.losses = saturate(results.losses);
+      entries.push_back(entry);
+    }
+    first = last;
+  }
+  return entries;
+}
+
+bool parseOptions(int argc, char *argv[], Options &options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+    if ((argument == "--plies" || argument == "--min-games" ||
+         argument == "--threads") &&
+        i + 1 < argc) {
+      int value = 0;
+      try {
+        value = std::stoi(argv[++i]);
+      } catch (const std::exception &) {
+        return false;
+      }
+      if (argument == "--plies") {
+        options.plies = value;
+      } else if (argument == "--min-games") {
+        options.minGames = value;
+      } else {
+        options.threads = std::max(1, value);
+      }
+    } else if (options.output.empty()) {
+      options.output = argument;
+    } else {
+      options.inputs.push_back(argument);
+    }
+  }
+  return !options.output.empty() && !options.inputs.empty();
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::cerr << "Usage: makeBook [--plies N] [--min-games N] [--threads N] "
+                 "book.bin games.pgn ..."
+              << std::endl;
+    return 1;
+  }
+
+  const auto threadCount = static_cast<std::size_t>(options.threads);
+  std::vector<MoveCounts> counts(threadCount);
+  std::vector<long> games(threadCount, 0);
+  std::mutex mutex;
+  std::condition_variable chunkDone;
+  std::size_t waitingChunks = 0;
+  auto readFailed = false;
+  {
+    // Each worker counts into its own map, the pool reads every chunk before
+    // it is destroyed. Reading the files waits while two chunks per worker
+    // are waiting, so a large file is not held in memory all at once.
+    ThreadPool pool(options.threads);
+    const auto submitChunk = [&](std::string chunk) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        chunkDone.wait(lock,
+                       [&]() { return waitingChunks < 2 * threadCount; });
+        waitingChunks++;
+      }
+      pool.submit([&, chunk = std::move(chunk)]() {
+        const auto worker = pool.getWorkerIndex();
+        countGames(chunk, options.plies, counts[worker], games[worker]);
+        std::lock_guard<std::mutex> lock(mutex);
+        waitingChunks--;
+        chunkDone.notify_all();
+      });
+    };
+    for (const auto &input : options.inputs) {
+      if (!splitFile(input, submitChunk)) {
+        readFailed = true;
+        break;
+      }
+    }
+  }
+  if (readFailed) {
+    return 1;
+  }
+
+  auto &merged = counts[0];
+  long totalGames = games[0];
+  for (std::size_t i = 1; i < threadCount; i++) {
+    for (const auto &count : counts[i]) {
+      auto &results = merged[count.first];
+      results.wins += count.second.wins;
+      results.draws += count.second.draws;
+      results.losses += count.second.losses;
+    }
+    totalGames += games[i];
+  }
+
+  const auto entries = makeEntries(merged, options.minGames);
+  if (!BookFile::write(options.output, entries)) {
+    std::cerr << "Could not write " << options.output << std::endl;
+    return 1;
+  }
+  std::cout << "Games read      : " << totalGames << std::endl;
+  std::cout << "Moves counted   : " << merged.size() << std::endl;
+  std::cout << "Book entries    : " << entries.size() << std::endl;
+}
@@ -0,0 +1,89 @@
+#include "chess/pgn.h"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Measures how fast PGN files are read, first the move text alone and then
+// with every move decoded and played. Without a file it reads a generated
+// collection of copies of one annotated game.
+// Usage: pgnBench [games.pgn]
+
+const std::string sampleGame = R"([Event "Sample"]
+[Site "?"]
+[White "White"]
+[Black "Black"]
+[Result "1-0"]
+
+1. e4 e5 2. Nf3 Nc6 3. Bb5 {The Ruy Lopez.} a6 4. Ba4 Nf6 5. O-O Be7
+6. Re1 b5 7. Bb3 d6 8. c3 O-O 9. h3 Nb8 (9... Na5 10. Bc2 c5 11. d4 Qc7)
+10. d4 Nbd7 11. Nbd2 Bb7 12. Bc2 Re8 13. Nf1 Bf8 14. Ng3 g6 15. a4 c5
+16. d5 c4 $1 17. Bg5 h6 18. Be3 Nc5 19. Qd2 h5 20. Bg5 Be7 21. Ra3 Nh7
+22. Bxe7 Rxe7 23. axb5 axb5 24. Rea1 Rxa3 25. Rxa3 Qb6 26. Qe3 Rc7
+27. Ra5 Nd7 28. Ra2 Nc5 1-0
+
+)";
+
+struct BenchResult {
+  long games = 0;
+  long moves = 0;
+  double seconds = 0;
+};
+
+BenchResult readAll(const std::string &text, bool playMoves) {
+  BenchResult result;
+  std::istringstream input(text);
+  PgnReader reader(input);
+  PgnGame game;
+
+  const auto startTime = std::chrono::steady_clock::now();
+  while (reader.readGame(game)) {
+    result.games++;
+    if (!playMoves) {
+      result.moves += game.moves.size();
+      continue;
+    }
+    Board board;
+    for (const auto &move : game.moves) {
+      if (!playSan(board, move)) {
+        break;
+      }
+      result.moves++;
+    }
+  }
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - startTime)
+                       .count();
+  return result;
+}
+
+void print(const std::string &name, const BenchResult &result,
+           std::size_t bytes) {
+  std::cout << name << ": " << result.games << " games, " << result.moves
+            << " moves in " << result.seconds << " s, "
+            << bytes / result.seconds / 1e6 << " MB/s, "
+            << result.games / result.seconds << " games/s, "
+            << result.moves / result.seconds << " moves/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  std::string text;
+  if (argc > 1) {
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+      std::cerr << "Could not open " << argv[1] << std::endl;
+      return 1;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    text = contents.str();
+  } else {
+    for (int i = 0; i < 20000; i++) {
+      text += sampleGame;
+    }
+  }
+
+  print("Read", readAll(text, false), text.size());
+  print("Read and play", readAll(text, true), text.size());
+}
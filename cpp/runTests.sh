@@ -1,8 +1,18 @@
 bazel run --test_output=all //:gameTests
 bazel run --test_output=all //:boardTests
+bazel run --test_output=all //:computerTests
 bazel run --test_output=all //:helpersTests
 bazel run --test_output=all //:moveTests
 bazel run --test_output=all //:pieceTests
 bazel run --test_output=all //:squareTests
 bazel run --test_output=all //:openingBookTests
+bazel run --test_output=all //:simdTests
+bazel run --test_output=all //:timeManagerTests
+bazel run --test_output=all //:transpositionTableTests
+bazel run --test_output=all //:bookFileTests
+bazel run --test_output=all //:pgnTests
+bazel run --test_output=all //:fenTests
+bazel run --test_output=all //:batchAnalysisTests
+bazel run --test_output=all //:sessionManagerTests
+bazel run --test_output=all //:threadPoolTests
 # ./bazel-bin/test
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "../chess/batchAnalysis.h"
+#include "../chess/helpers.h"
+#include <gtest/gtest.h>
+
+// White mates with Ra8.
+const std::string mateInOne = "6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1";
+
+TEST(BatchAnalysisTests, ReadsFenLines) {
+  AnalysisLimits defaults;
+  defaults.maxDepth = 3;
+  AnalysisRequest request;
+
+  ASSERT_TRUE(parseAnalysisLine(std::string(START_FEN) + "\r\n", defaults,
+                                request));
+  EXPECT_EQ(request.fen, START_FEN);
+  EXPECT_EQ(request.limits.maxDepth, 3);
+  EXPECT_TRUE(request.id.empty());
+
+  EXPECT_FALSE(parseAnalysisLine("   ", defaults, request));
+  EXPECT_FALSE(parseAnalysisLine("# a comment", defaults, request));
+}
+
+TEST(BatchAnalysisTests, ReadsLimitsFromEpdOperations) {
+  AnalysisLimits defaults;
+  AnalysisRequest request;
+
+  ASSERT_TRUE(parseAnalysisLine(
+      "6k1/5ppp/8/8/8/8/8/R5K1 w - - bm Ra8#; id \"mate 1\"; depth 4; "
+      "nodes 5000;",
+      defaults, request));
+  EXPECT_EQ(request.fen, "6k1/5ppp/8/8/8/8/8/R5K1 w - -");
+  EXPECT_EQ(request.id, "mate 1");
+  EXPECT_EQ(request.limits.maxDepth, 4);
+  EXPECT_EQ(request.limits.nodeLimit, 5000);
+  EXPECT_EQ(request.limits.milliseconds, 0);
+
+  ASSERT_TRUE(parseAnalysisLine(mateInOne + " movetime 20;", defaults,
+                                request));
+  EXPECT_EQ(request.fen, mateInOne);
+  EXPECT_EQ(request.limits.milliseconds, 20);
+  EXPECT_TRUE(request.id.empty());
+}
+
+TEST(BatchAnalysisTests, FindsMate) {
+  AnalysisRequest request;
+  request.fen = mateInOne;
+  request.limits.maxDepth = 3;
+
+  const auto result =
+      analyzePosition(request, std::make_shared<TranspositionTable>());
+  ASSERT_TRUE(result.valid);
+  EXPECT_EQ(moveToCoordinates(result.bestMove), "a1a8");
+  EXPECT_EQ(result.line.mateIn, 1);
+  EXPECT_GT(result.stats.nodes, 0);
+}
+
+TEST(BatchAnalysisTests, SearchesWithTheGivenTable) {
+  AnalysisRequest request;
+  request.fen = START_FEN;
+  request.limits.maxDepth = 3;
+  auto table = std::make_shared<TranspositionTable>(1024);
+
+  analyzePosition(request, table);
+  EXPECT_TRUE(table->probe(Board().getHash()));
+}
+
+TEST(BatchAnalysisTests, ReportsInvalidPositions) {
+  AnalysisRequest request;
+  request.fen = "not a position";
+
+  const auto result =
+      analyzePosition(request, std::make_shared<TranspositionTable>());
+  EXPECT_FALSE(result.valid);
+  EXPECT_EQ(result.fen, "not a position");
+}
+
+TEST(BatchAnalysisTests, AnalyzesEveryPositionOnce) {
+  for (auto shareTable : {false, true}) {
+    std::vector<int> seen(12, 0);
+    std::vector<std::string> bestMoves(12);
+    {
+      ThreadPool pool(3);
+      BatchAnalysis analysis(pool, shareTable,
+                             [&](const AnalysisResult &result) {
+                               seen[result.index]++;
+                               bestMoves[result.index] =
+                                   moveToCoordinates(result.bestMove);
+                             });
+      EXPECT_EQ(analysis.getThreadCount(), 3);
+      for (std::size_t i = 0; i < seen.size(); i++) {
+        AnalysisRequest request;
+        request.index = i;
+        request.fen = i % 2 == 0 ? mateInOne : START_FEN;
+        request.limits.maxDepth = 3;
+        analysis.add(request);
+      }
+      analysis.finish();
+    }
+
+    for (std::size_t i = 0; i < seen.size(); i++) {
+      EXPECT_EQ(seen[i], 1);
+      if (i % 2 == 0) {
+        EXPECT_EQ(bestMoves[i], "a1a8");
+      }
+    }
+  }
+}
@@ -398,3 +398,136 @@ TEST(NewBoardTests, ThreeFoldRepetition) {
 }
 
 // insufficent material draw
+
+Squares emptySquares() {
+  Squares squares(BOARD_LENGTH, std::vector<Square>(BOARD_LENGTH));
+  for (int i = 0; i < BOARD_LENGTH; i++) {
+    for (int j = 0; j < BOARD_LENGTH; j++) {
+      squares[i][j] = Square(i, j);
+    }
+  }
+  return squares;
+}
+
+TEST(StaticExchangeTests, EqualPawnTrade) {
+  Board newBoard;
+  moveMaker("e2-e4 d7-d5", newBoard);
+
+  EXPECT_TRUE(newBoard.isCapture(Move(4, 4, 3, 3)));
+  EXPECT_EQ(newBoard.see(Move(4, 4, 3, 3)), 0);
+}
+
+TEST(StaticExchangeTests, QueenTakesDefendedPawn) {
+  Board newBoard;
+  moveMaker("e2-e4 e7-e5 Qd1-h5 a7-a6", newBoard);
+
+  // Qh5xf7 is recaptured by the king, Qh5xe5 is not defended
+  EXPECT_EQ(newBoard.see(Move(3, 7, 1, 5)), 10 - 90);
+  EXPECT_EQ(newBoard.see(Move(3, 7, 3, 4)), 10);
+}
+
+TEST(StaticExchangeTests, XRayAttacker) {
+  auto squares = emptySquares();
+  squares[7][3] = Square(7, 3, Piece(ROOK, WHITE));
+  squares[6][3] = Square(6, 3, Piece(ROOK, WHITE));
+  squares[1][3] = Square(1, 3, Piece(PAWN, BLACK));
+  squares[0][3] = Square(0, 3, Piece(ROOK, BLACK));
+  Board newBoard(squares, {}, WHITE, Square(), {});
+
+  // Rd2xd7 Rd8xd7 Rd1xd7 wins a pawn thanks to the rook behind
+  EXPECT_EQ(newBoard.see(Move(6, 3, 1, 3)), 10);
+}
+
+TEST(StaticExchangeTests, QuietMoveIsNotCapture) {
+  Board newBoard;
+  EXPECT_FALSE(newBoard.isCapture(Move(6, 4, 4, 4)));
+  EXPECT_EQ(newBoard.see(Move(6, 4, 4, 4)), 0);
+}
+
+TEST(AttackedSquareTests, StartingPosition) {
+  Board newBoard;
+
+  EXPECT_TRUE(newBoard.isSquareAttacked(5, 5, WHITE));
+  EXPECT_FALSE(newBoard.isSquareAttacked(4, 4, WHITE));
+  EXPECT_TRUE(newBoard.isSquareAttacked(2, 0, BLACK));
+  EXPECT_FALSE(newBoard.isSquareAttacked(5, 0, BLACK));
+
+  // f3 is covered by the g1 knight and the e2 and g2 pawns
+  EXPECT_EQ(bitboard::countBits(newBoard.attackersTo(5, 5)), 3);
+}
+
+TEST(AttackedSquareTests, SliderIsBlocked) {
+  Board newBoard;
+  moveMaker("e2-e4 e7-e5 Qd1-h5", newBoard);
+
+  EXPECT_TRUE(newBoard.isSquareAttacked(1, 5, WHITE));
+  EXPECT_FALSE(newBoard.isSquareAttacked(0, 4, WHITE));
+}
+
+void expectBitboardsMatchSquares(const Board &board) {
+  Board rebuilt(board.getSquares(), {}, WHITE, Square(), {});
+  const auto &bitboards = board.getPieceBitboards();
+  const auto &expected = rebuilt.getPieceBitboards();
+  for (int color = 0; color < COLOR_COUNT; color++) {
+    EXPECT_EQ(bitboards.colors[color], expected.colors[color]);
+    for (int type = 0; type < PIECE_TYPE_COUNT; type++) {
+      EXPECT_EQ(bitboards.pieces[color][type], expected.pieces[color][type]);
+    }
+  }
+}
+
+TEST(PieceBitboardTests, StartingPosition) {
+  Board newBoard;
+  const auto &bitboards = newBoard.getPieceBitboards();
+  EXPECT_EQ(bitboard::countBits(bitboards.colors[WHITE_INDEX]), 16);
+  EXPECT_EQ(bitboard::countBits(bitboards.colors[BLACK_INDEX]), 16);
+  EXPECT_EQ(bitboards.pieces[WHITE_INDEX][KING_INDEX],
+            bitboard::squareBit(toSquareIndex(7, 4)));
+}
+
+TEST(PieceBitboardTests, FollowsCastlingEnPassantAndPromotion) {
+  Board newBoard;
+  newBoard.setPromotionType(QUEEN);
+  moveMaker("g2-g3 g7-g6 Bf1-g2 Bf8-g7 Kng1-f3 Kng8-f6 Ke1-g1 d7-d5 "
+            "e2-e4 d5-d4 c2-c4 d4-c3 b2-c3 a7-a5 h2-h4 a5-a4 h4-h5 a4-a3 "
+            "h5-g6 Bc8-e6 g6-f7 Ke8-d7",
+            newBoard);
+  expectBitboardsMatchSquares(newBoard);
+
+  moveMaker("f7-f8", newBoard);
+  EXPECT_EQ(newBoard.getSquare(0, 5).getPiece().getType(), QUEEN);
+  expectBitboardsMatchSquares(newBoard);
+}
+
+TEST(SearchPathTests, HashFollowsTranspositions) {
+  Board first;
+  Board second;
+  moveMaker("Kng1-f3 Kng8-f6 Knb1-c3", first);
+  moveMaker("Knb1-c3 Kng8-f6 Kng1-f3", second);
+
+  EXPECT_EQ(first.getHash(), second.getHash());
+  EXPECT_NE(first.getHash(), Board().getHash());
+}
+
+TEST(SearchPathTests, SearchMoveMatchesGameMove) {
+  Board gameBoard;
+  Board searchBoard;
+  moveMaker("e2-e4 d7-d5", gameBoard);
+  searchBoard.makeSearchMove(Move(6, 4, 4, 4));
+  searchBoard.makeSearchMove(Move(1, 3, 3, 3));
+
+  EXPECT_EQ(searchBoard.getHash(), gameBoard.getHash());
+  EXPECT_EQ(searchBoard.getTurn(), WHITE);
+  EXPECT_EQ(searchBoard.getSquare(3, 3).getPiece().getType(), PAWN);
+  EXPECT_EQ(searchBoard.getSquare(1, 3).getPiece().getType(), "");
+}
+
+TEST(SearchPathTests, MatedSideHasNoLegalMove) {
+  Board newBoard;
+  moveMaker("e2-e4 e7-e5 Qd1-h5 a7-a6 Bf1-c4 a6-a5", newBoard);
+  EXPECT_TRUE(newBoard.hasLegalMove());
+
+  newBoard.makeSearchMove(Move(3, 7, 1, 5));
+  EXPECT_TRUE(newBoard.isInCheck());
+  EXPECT_FALSE(newBoard.hasLegalMove());
+}
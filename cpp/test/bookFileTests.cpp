@@ -0,0 +1,57 @@
+#include "../chess/bookFile.h"
+#include <fstream>
+#include <gtest/gtest.h>
+
+std::string bookPath(const std::string &name) {
+  return testing::TempDir() + name;
+}
+
+BookEntry bookEntry(std::uint64_t key, const Move &move, int weight) {
+  BookEntry entry;
+  entry.key = key;
+  entry.move = BookEntry::encodeMove(move);
+  entry.weight = weight;
+  entry.wins = weight * 10;
+  entry.draws = weight * 6;
+  entry.losses = weight * 4;
+  return entry;
+}
+
+TEST(BookFileTests, EncodesMoves) {
+  const Move move(6, 4, 4, 4);
+  EXPECT_EQ(bookEntry(1, move, 1).getMove(), move);
+}
+
+TEST(BookFileTests, FindsAllMovesOfAPosition) {
+  const auto path = bookPath("findsAllMoves.bin");
+  ASSERT_TRUE(BookFile::write(path, {bookEntry(30, Move(1, 1, 2, 2), 1),
+                                     bookEntry(20, Move(6, 4, 4, 4), 5),
+                                     bookEntry(10, Move(7, 6, 5, 5), 2),
+                                     bookEntry(20, Move(6, 3, 4, 3), 3)}));
+
+  BookFile book;
+  ASSERT_TRUE(book.open(path));
+  EXPECT_EQ(book.size(), 4);
+
+  const auto entries = book.probe(20);
+  ASSERT_EQ(entries.size(), 2);
+  EXPECT_EQ(entries[0].getMove(), Move(6, 4, 4, 4));
+  EXPECT_EQ(entries[0].weight, 5);
+  EXPECT_EQ(entries[0].wins, 50);
+  EXPECT_EQ(entries[0].draws, 30);
+  EXPECT_EQ(entries[0].losses, 20);
+  EXPECT_EQ(entries[1].getMove(), Move(6, 3, 4, 3));
+  EXPECT_TRUE(book.probe(15).empty());
+  EXPECT_TRUE(book.probe(40).empty());
+}
+
+TEST(BookFileTests, RejectsOtherFiles) {
+  const auto path = bookPath("notABook.bin");
+  std::ofstream(path) << "1. e4 e5 2. Nf3 Nc6";
+
+  BookFile book;
+  EXPECT_FALSE(book.open(path));
+  EXPECT_FALSE(book.isOpen());
+  EXPECT_FALSE(book.open(bookPath("missing.bin")));
+  EXPECT_TRUE(book.probe(20).empty());
+}
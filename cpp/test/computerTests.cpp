@@ -0,0 +1,257 @@
+#include "../chess/computer.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+std::shared_ptr<Board> boardAfter(const std::string &moves) {
+  auto board = std::make_shared<Board>();
+  board->setPromotionType(QUEEN);
+  auto convertedMoves = stringToMoves(moves);
+  while (!convertedMoves.empty()) {
+    auto move = convertedMoves.front();
+    convertedMoves.pop();
+    board->calcAndGetLegalMoves(move.startRow, move.startCol);
+    board->makeAMove(move.startRow, move.startCol, move.endRow, move.endCol);
+  }
+  return board;
+}
+
+bool isLegal(std::shared_ptr<Board> board, const Move &move) {
+  auto legalMoves = board->calcAndGetLegalMoves(move.startRow, move.startCol);
+  return std::find_if(begin(legalMoves), end(legalMoves),
+                      [&move](const Square &square) {
+                        return square.getRow() == move.endRow &&
+                               square.getCol() == move.endCol;
+                      }) != end(legalMoves);
+}
+
+TEST(ComputerTests, FindsMateInOne) {
+  auto board = boardAfter("e2-e4 e7-e5 Qd1-h5 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(500));
+
+  auto move = computer.findMove();
+  EXPECT_EQ(move.startRow, 3);
+  EXPECT_EQ(move.startCol, 7);
+  EXPECT_EQ(move.endRow, 1);
+  EXPECT_EQ(move.endCol, 5);
+}
+
+TEST(ComputerTests, RespectsHardTimeLimit) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6 "
+                          "d2-d4 e5-d4 e4-e5 d7-d5 Bc4-b5 Knf6-e4");
+  Computer computer(board, WHITE, std::chrono::milliseconds(200));
+
+  auto startTime = std::chrono::steady_clock::now();
+  auto move = computer.findMove();
+  auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+  EXPECT_LT(elapsed, std::chrono::milliseconds(200 + 100));
+  EXPECT_TRUE(isLegal(board, move));
+}
+
+TEST(ComputerTests, StopsWhenAsked) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(10000));
+
+  std::thread stopper([&computer]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    computer.stop();
+  });
+  auto startTime = std::chrono::steady_clock::now();
+  auto move = computer.findMove();
+  auto elapsed = std::chrono::steady_clock::now() - startTime;
+  stopper.join();
+
+  EXPECT_LT(elapsed, std::chrono::milliseconds(1000));
+  EXPECT_TRUE(isLegal(board, move));
+}
+
+TEST(ComputerTests, SearchesInSlices) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(300));
+
+  computer.startSearch();
+  int steps = 0;
+  auto longestStep = std::chrono::steady_clock::duration::zero();
+  auto finished = false;
+  while (!finished) {
+    auto startTime = std::chrono::steady_clock::now();
+    finished = computer.step(std::chrono::milliseconds(5));
+    longestStep =
+        std::max(longestStep, std::chrono::steady_clock::now() - startTime);
+    steps++;
+  }
+
+  EXPECT_GT(steps, 10);
+  EXPECT_LT(longestStep, std::chrono::milliseconds(50));
+  EXPECT_TRUE(computer.isSearchFinished());
+  EXPECT_TRUE(isLegal(board, computer.getBestMove()));
+}
+
+TEST(ComputerTests, FillsSearchStats) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(300));
+  std::vector<int> reportedDepths;
+  computer.setIterationCallback([&reportedDepths](const SearchStats &stats) {
+    reportedDepths.push_back(stats.depth);
+  });
+
+  computer.findMove();
+  const auto stats = computer.getStats();
+
+  EXPECT_GT(stats.depth, 2);
+  EXPECT_EQ(stats.iterations.size(), stats.depth);
+  EXPECT_EQ(reportedDepths.size(), stats.depth);
+  EXPECT_EQ(reportedDepths.back(), stats.depth);
+
+  long iterationNodes = 0;
+  for (const auto &iteration : stats.iterations) {
+    iterationNodes += iteration.nodes;
+  }
+  EXPECT_LE(iterationNodes, stats.nodes);
+  EXPECT_GT(stats.nodesPerSecond, 0);
+  EXPECT_GT(stats.effectiveBranchingFactor, 1);
+  EXPECT_GT(stats.tableHits, 0);
+  EXPECT_LE(stats.tableHitRate, 1);
+  EXPECT_GT(stats.firstMoveCutoffRate, 0);
+  EXPECT_LE(stats.firstMoveCutoffRate, 1);
+}
+
+TEST(ComputerTests, PrincipalVariationIsPlayable) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(300));
+
+  const auto move = computer.findMove();
+  const auto lines = computer.getLines();
+  ASSERT_EQ(lines.size(), 1);
+  ASSERT_GE(lines[0].moves.size(), 2);
+  EXPECT_EQ(lines[0].moves[0], move);
+
+  auto position = std::make_shared<Board>(board);
+  position->setPromotionType(QUEEN);
+  for (const auto &lineMove : lines[0].moves) {
+    ASSERT_TRUE(isLegal(position, lineMove));
+    position->makeAMove(lineMove.startRow, lineMove.startCol, lineMove.endRow,
+                        lineMove.endCol);
+  }
+}
+
+TEST(ComputerTests, ReportsMateFromWhitesPointOfView) {
+  auto board = boardAfter("e2-e4 e7-e5 Qd1-h5 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(500));
+  computer.findMove();
+  EXPECT_EQ(computer.getLines()[0].mateIn, 1);
+
+  auto blackToMate = boardAfter("f2-f3 e7-e5 g2-g4");
+  Computer blackComputer(blackToMate, BLACK, std::chrono::milliseconds(500));
+  blackComputer.findMove();
+  EXPECT_EQ(blackComputer.getLines()[0].mateIn, -1);
+}
+
+TEST(ComputerTests, MultiPvRanksSeveralMovesInOneSearch) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  Computer computer(board, WHITE, std::chrono::milliseconds(300));
+  computer.setMultiPv(3);
+
+  computer.findMove();
+  const auto lines = computer.getLines();
+  ASSERT_EQ(lines.size(), 3);
+  EXPECT_FALSE(lines[0].moves[0] == lines[1].moves[0]);
+  EXPECT_FALSE(lines[1].moves[0] == lines[2].moves[0]);
+  EXPECT_GE(lines[0].centipawns, lines[1].centipawns);
+  EXPECT_GE(lines[1].centipawns, lines[2].centipawns);
+}
+
+TEST(ComputerTests, StrengthLevelFixesTheWork) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  const auto level = Computer::getStrengthLevel(3);
+
+  for (int i = 0; i < 3; i++) {
+    Computer computer(board, WHITE, std::chrono::milliseconds(0));
+    computer.setStrengthLevel(3);
+    const auto move = computer.findMove();
+    const auto stats = computer.getStats();
+
+    EXPECT_TRUE(isLegal(board, move));
+    EXPECT_LE(stats.nodes, level.nodeLimit);
+    EXPECT_LE(stats.depth, level.maxDepth);
+  }
+}
+
+TEST(ComputerTests, RandomMarginKeepsNearBestMoves) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+  const auto level = Computer::getStrengthLevel(1);
+  ASSERT_GT(level.randomMargin, 0);
+
+  Computer computer(board, WHITE, std::chrono::milliseconds(0));
+  computer.setStrengthLevel(1);
+  computer.setMultiPv(100);
+  const auto move = computer.findMove();
+  const auto lines = computer.getLines();
+
+  auto played = std::find_if(
+      begin(lines), end(lines),
+      [&move](const AnalysisLine &line) { return line.moves[0] == move; });
+  ASSERT_NE(played, end(lines));
+  EXPECT_GE(played->centipawns, lines[0].centipawns - level.randomMargin * 10);
+}
+
+TEST(ComputerTests, SearchLimitsMakeTheSearchRepeatable) {
+  auto board = boardAfter("e2-e4 e7-e5 Kng1-f3 Knb8-c6 Bf1-c4 Kng8-f6");
+
+  std::vector<Move> moves;
+  std::vector<long> nodes;
+  std::vector<std::vector<Move>> lines;
+  for (int i = 0; i < 2; i++) {
+    Computer computer(board, WHITE, std::chrono::milliseconds(0));
+    computer.setSeed(7);
+    computer.setSearchLimits(4, 0);
+    moves.push_back(computer.findMove());
+    nodes.push_back(computer.getStats().nodes);
+    lines.push_back(computer.getLines()[0].moves);
+  }
+
+  EXPECT_EQ(moves[0], moves[1]);
+  EXPECT_EQ(nodes[0], nodes[1]);
+  EXPECT_EQ(lines[0], lines[1]);
+}
+
+// Game searches on a copy of its computer, the copies must not repeat the
+// original's random picks.
+TEST(ComputerTests, CopiesShareTheRandomNumbers) {
+  auto board = std::make_shared<Board>();
+  std::vector<Move> original;
+  std::vector<Move> copied;
+  Computer computer(board, WHITE, std::chrono::milliseconds(0));
+  Computer owner(board, WHITE, std::chrono::milliseconds(0));
+  computer.setStrengthLevel(1);
+  owner.setStrengthLevel(1);
+  computer.setSeed(3);
+  owner.setSeed(3);
+  for (int i = 0; i < 8; i++) {
+    original.push_back(computer.findMove());
+    auto searcher = owner;
+    copied.push_back(searcher.findMove());
+  }
+
+  EXPECT_EQ(copied, original);
+  EXPECT_FALSE(std::all_of(begin(copied), end(copied), [&](const Move &move) {
+    return move == copied.front();
+  }));
+}
+
+TEST(ComputerTests, AllocatesItsTableOnTheFirstSearch) {
+  auto board = std::make_shared<Board>();
+  Computer computer(board, WHITE, std::chrono::milliseconds(0));
+  computer.setTableSize(1024);
+  computer.setSearchLimits(2, 0);
+  EXPECT_FALSE(computer.hasTable());
+  EXPECT_EQ(computer.getTableMove(board), Move(0, 0, 0, 0));
+  EXPECT_FALSE(computer.hasTable());
+
+  computer.findMove();
+  ASSERT_TRUE(computer.hasTable());
+  EXPECT_TRUE(computer.getTable()->probe(board->getHash()));
+
+  computer.setTableSize(2048);
+  EXPECT_FALSE(computer.hasTable());
+}
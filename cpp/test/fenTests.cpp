@@ -0,0 +1,101 @@
+#include "../chess/board.h"
+#include <gtest/gtest.h>
+
+void play(Board &board, int startRow, int startCol, int endRow, int endCol) {
+  board.setPromotionType(QUEEN);
+  board.calcAndGetLegalMoves(startRow, startCol);
+  board.makeAMove(startRow, startCol, endRow, endCol);
+}
+
+bool canMoveTo(Board &board, int startRow, int startCol, int endRow,
+               int endCol) {
+  const auto moves = board.calcAndGetLegalMoves(startRow, startCol);
+  return std::any_of(begin(moves), end(moves), [&](const Square &square) {
+    return square.getRow() == endRow && square.getCol() == endCol;
+  });
+}
+
+TEST(FenTests, StartPosition) {
+  Board board;
+  EXPECT_EQ(board.toFEN(), START_FEN);
+
+  const auto parsed = Board::fromFEN(START_FEN);
+  ASSERT_NE(parsed, nullptr);
+  EXPECT_EQ(parsed->getHash(), board.getHash());
+  EXPECT_EQ(parsed->toFEN(), START_FEN);
+}
+
+TEST(FenTests, WritesEnPassantCastlingAndClocks) {
+  Board board;
+  play(board, 6, 4, 4, 4);
+  EXPECT_EQ(board.toFEN(),
+            "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1");
+  play(board, 0, 6, 2, 5);
+  play(board, 7, 4, 6, 4);
+  EXPECT_EQ(board.toFEN(),
+            "rnbqkb1r/pppppppp/5n2/8/4P3/8/PPPPKPPP/RNBQ1BNR b kq - 2 2");
+}
+
+TEST(FenTests, RoundTrips) {
+  const std::string fens[] = {
+      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+      "rnbqkb1r/ppp1pppp/5n2/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3",
+      "r3k3/8/8/8/8/8/8/4K2R b Kq - 37 60",
+  };
+  for (const auto &fen : fens) {
+    const auto board = Board::fromFEN(fen);
+    ASSERT_NE(board, nullptr) << fen;
+    EXPECT_EQ(board->toFEN(), fen);
+  }
+}
+
+TEST(FenTests, EnPassantAndCastlingRightsAreKept) {
+  auto board = Board::fromFEN(
+      "rnbqkb1r/ppp1pppp/5n2/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3");
+  ASSERT_NE(board, nullptr);
+  EXPECT_TRUE(canMoveTo(*board, 3, 4, 2, 3));
+  play(*board, 3, 4, 2, 3);
+  EXPECT_EQ(board->getSquare(3, 3).getPiece().getType(), "");
+
+  auto noCastling = Board::fromFEN("r3k2r/8/8/8/8/8/8/R3K2R w Kq - 0 1");
+  ASSERT_NE(noCastling, nullptr);
+  EXPECT_TRUE(canMoveTo(*noCastling, 7, 4, 7, 6));
+  EXPECT_FALSE(canMoveTo(*noCastling, 7, 4, 7, 2));
+}
+
+TEST(FenTests, ReadsTheHalfmoveClock) {
+  auto board = Board::fromFEN("4k3/8/8/8/8/8/8/R3K3 w - - 99 80");
+  ASSERT_NE(board, nullptr);
+  EXPECT_EQ(board->getGameInfo().getStatus(), "");
+  play(*board, 7, 0, 6, 0);
+  EXPECT_EQ(board->getGameInfo().getStatus(), DRAW_BY_50_MOVE_RULE);
+}
+
+TEST(FenTests, AcceptsEpdWithoutClocks) {
+  const auto board = Board::fromFEN("4k3/8/8/8/8/8/8/R3K3 b - -");
+  ASSERT_NE(board, nullptr);
+  EXPECT_EQ(board->toFEN(), "4k3/8/8/8/8/8/8/R3K3 b - - 0 1");
+}
+
+TEST(FenTests, RejectsInvalidPositions) {
+  const std::string fens[] = {
+      "",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1",
+      "rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQ1BNR w kq - 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR x KQkq - 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkk - 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBN1 w KQkq - 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq e3 0 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - -1 1",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 0",
+      "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1 extra",
+      "Pnbqkbnr/pppppppp/8/8/8/8/1PPPPPPP/RNBQKBNR w Qkq - 0 1",
+      "4k3/4R3/8/8/8/8/8/4K3 w - - 0 1",
+  };
+  for (const auto &fen : fens) {
+    EXPECT_EQ(Board::fromFEN(fen), nullptr) << fen;
+  }
+}
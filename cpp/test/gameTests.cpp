@@ -1,5 +1,6 @@
 #include "../chess/game.h"
 #include <gtest/gtest.h>
+#include <thread>
 
 TEST(GameTests, MovePiecesWithoutOpeningBook) {
   Game game;
@@ -28,3 +29,163 @@ TEST(GameTests, MovePiecesWithOpeningBook) {
   auto whites_turn = game.getTurn();
   EXPECT_EQ(whites_turn, WHITE);
 }
+
+TEST(GameTests, ComputerMoveOnClock) {
+  Game game;
+  game.newGame(WHITE, 0, false);
+  game.setComputerClock(2000, 0, 0);
+  game.calcAndGetLegalMoves(6, 4);
+  game.makeAMove(6, 4, 4, 4);
+
+  auto startTime = std::chrono::steady_clock::now();
+  game.makeComputerMove();
+  auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+  EXPECT_EQ(game.getTurn(), WHITE);
+  EXPECT_LT(elapsed, std::chrono::milliseconds(1000));
+}
+
+TEST(GameTests, AsynchronousComputerMove) {
+  Game game;
+  game.newGame(WHITE, 500, false);
+  game.calcAndGetLegalMoves(6, 4);
+  game.makeAMove(6, 4, 4, 4);
+
+  auto startTime = std::chrono::steady_clock::now();
+  game.startComputerMove();
+  EXPECT_LT(std::chrono::steady_clock::now() - startTime,
+            std::chrono::milliseconds(100));
+  EXPECT_FALSE(game.isComputerMoveReady());
+
+  while (!game.isComputerMoveReady()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_GT(game.getSearchProgress().depth, 0);
+  EXPECT_GT(game.getSearchProgress().nodes, 0);
+
+  game.waitComputerMove();
+  EXPECT_EQ(game.getTurn(), WHITE);
+}
+
+TEST(GameTests, NewGameDoesNotWaitForTheSearch) {
+  Game game;
+  game.newGame(WHITE, 10000, false);
+  game.calcAndGetLegalMoves(6, 4);
+  game.makeAMove(6, 4, 4, 4);
+  game.startComputerMove();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  auto startTime = std::chrono::steady_clock::now();
+  game.newGame(WHITE, 1000, false);
+  auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+  EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+  EXPECT_EQ(game.getTurn(), WHITE);
+  EXPECT_TRUE(game.isComputerMoveReady());
+}
+
+TEST(GameTests, ComputerMoveInSteps) {
+  Game game;
+  game.newGame(WHITE, 300, false);
+  game.calcAndGetLegalMoves(6, 4);
+  game.makeAMove(6, 4, 4, 4);
+
+  int steps = 0;
+  while (!game.stepComputerMove(5000)) {
+    steps++;
+  }
+  EXPECT_GT(steps, 10);
+  EXPECT_EQ(game.getTurn(), BLACK);
+
+  game.waitComputerMove();
+  EXPECT_EQ(game.getTurn(), WHITE);
+}
+
+TEST(GameTests, MovesOnTheComputersTurnKeepItsSearch) {
+  Game game;
+  game.newGame(WHITE, 300, false);
+  game.calcAndGetLegalMoves(6, 4);
+  game.makeAMove(6, 4, 4, 4);
+  game.startComputerMove();
+
+  auto startTime = std::chrono::steady_clock::now();
+  game.makeAMove(6, 3, 4, 3);
+  EXPECT_LT(std::chrono::steady_clock::now() - startTime,
+            std::chrono::milliseconds(100));
+  EXPECT_EQ(game.getTurn(), BLACK);
+  EXPECT_EQ(game.getSquares()[6][3].getPiece().getType(), PAWN);
+
+  game.waitComputerMove();
+  EXPECT_EQ(game.getTurn(), WHITE);
+}
+
+TEST(GameTests, PonderHitPlaysQuickly) {
+  Game game;
+  game.newGame(BLACK, 300, false);
+  game.setPondering(true);
+  game.makeComputerMove();
+
+  const auto ponderMove = game.getPonderMove();
+  ASSERT_FALSE(ponderMove == Move(0, 0, 0, 0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+
+  game.calcAndGetLegalMoves(ponderMove.startRow, ponderMove.startCol);
+  game.makeAMove(ponderMove.startRow, ponderMove.startCol, ponderMove.endRow,
+                 ponderMove.endCol);
+  EXPECT_EQ(game.getTurn(), WHITE);
+
+  auto startTime = std::chrono::steady_clock::now();
+  game.makeComputerMove();
+  auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+  EXPECT_EQ(game.getTurn(), BLACK);
+  EXPECT_LT(elapsed, std::chrono::milliseconds(100));
+}
+
+TEST(GameTests, PonderMissSearchesAgain) {
+  Game game;
+  game.newGame(BLACK, 300, false);
+  game.setPondering(true);
+  game.makeComputerMove();
+
+  const auto ponderMove = game.getPonderMove();
+  ASSERT_FALSE(ponderMove == Move(0, 0, 0, 0));
+  const auto otherMove = ponderMove == Move(1, 0, 2, 0) ? Move(1, 7, 2, 7)
+                                                        : Move(1, 0, 2, 0);
+  game.calcAndGetLegalMoves(otherMove.startRow, otherMove.startCol);
+  game.makeAMove(otherMove.startRow, otherMove.startCol, otherMove.endRow,
+                 otherMove.endCol);
+  EXPECT_EQ(game.getTurn(), WHITE);
+  EXPECT_EQ(game.getPonderMove(), Move(0, 0, 0, 0));
+
+  game.makeComputerMove();
+  EXPECT_EQ(game.getTurn(), BLACK);
+}
+
+TEST(GameTests, ComputerMoveAtStrengthLevel) {
+  Game game;
+  game.newGame(WHITE, 0, false, 2);
+  game.calcAndGetLegalMoves(6, 4);
+  game.makeAMove(6, 4, 4, 4);
+  game.makeComputerMove();
+
+  EXPECT_EQ(game.getTurn(), WHITE);
+  EXPECT_LE(game.getSearchStats().nodes,
+            Computer::getStrengthLevel(2).nodeLimit);
+}
+
+TEST(GameTests, PlaysMovesFromABookFile) {
+  BookEntry entry;
+  entry.key = Board().getHash();
+  entry.move = BookEntry::encodeMove(Move(6, 0, 5, 0));
+  entry.weight = 1;
+  const auto path = testing::TempDir() + "gameBook.bin";
+  ASSERT_TRUE(BookFile::write(path, {entry}));
+
+  Game game;
+  game.newGame(BLACK, 1000, true);
+  ASSERT_TRUE(game.loadOpeningBook(path));
+  game.makeComputerMove();
+
+  EXPECT_EQ(game.getSquares()[5][0].getPiece().getType(), PAWN);
+}
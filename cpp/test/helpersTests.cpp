@@ -31,3 +31,8 @@ TEST(HelperTests, IsInsideBoard) {
   EXPECT_FALSE(isOutside3);
   EXPECT_FALSE(isOutside4);
 }
+
+TEST(HelperTests, MoveToCoordinates) {
+  EXPECT_EQ(moveToCoordinates(Move(6, 4, 4, 4)), "e2e4");
+  EXPECT_EQ(moveToCoordinates(Move(0, 6, 2, 5)), "g8f6");
+}
@@ -1,10 +1,24 @@
 #include "../chess/game.h"
+#include "../chess/openings.h"
 #include <gtest/gtest.h>
 
+std::uint64_t hashAfter(const std::string &moves) {
+  Board board;
+  board.setPromotionType(QUEEN);
+  auto convertedMoves = stringToMoves(moves);
+  while (!convertedMoves.empty()) {
+    auto move = convertedMoves.front();
+    convertedMoves.pop();
+    board.calcAndGetLegalMoves(move.startRow, move.startCol);
+    board.makeAMove(move.startRow, move.startCol, move.endRow, move.endCol);
+  }
+  return board.getHash();
+}
+
 TEST(OpeningBook, FindWhiteMove) {
 
   OpeningBook openingBook;
-  auto move = openingBook.findMove();
+  auto move = openingBook.findMove(hashAfter(""));
   EXPECT_TRUE(move.startRow >= 6 && move.startRow <= 7);
   EXPECT_TRUE(move.startCol >= 0 && move.startCol <= BOARD_LENGTH);
   EXPECT_TRUE(move.endRow >= 4 && move.endRow <= 7);
@@ -15,23 +29,85 @@ TEST(OpeningBook, FindBlackMove) {
 
   OpeningBook openingBook;
 
-  openingBook.traverse(Move(6, 4, 4, 4));
-  auto move = openingBook.findMove();
+  auto move = openingBook.findMove(hashAfter("e2-e4"));
   EXPECT_TRUE(move.startRow >= 0 && move.startRow <= 1);
   EXPECT_TRUE(move.startCol >= 0 && move.startCol <= BOARD_LENGTH);
   EXPECT_TRUE(move.endRow >= 0 && move.endRow <= 3);
   EXPECT_TRUE(move.endCol >= 0 && move.endCol <= BOARD_LENGTH);
 }
 
-TEST(OpeningBook, Reset) {
+TEST(OpeningBook, OutOfBook) {
 
   OpeningBook openingBook;
 
-  openingBook.traverse(Move(6, 4, 4, 4));
-  openingBook.reset(true);
-  auto move = openingBook.findMove();
-  EXPECT_TRUE(move.startRow >= 6 && move.startRow <= 7);
-  EXPECT_TRUE(move.startCol >= 0 && move.startCol <= BOARD_LENGTH);
-  EXPECT_TRUE(move.endRow >= 4 && move.endRow <= 7);
-  EXPECT_TRUE(move.endCol >= 0 && move.endCol <= BOARD_LENGTH);
+  EXPECT_EQ(openingBook.findMove(hashAfter("a2-a3")), Move(0, 0, 0, 0));
+  EXPECT_EQ(openingBook.findMove(hashAfter("d2-d4 d7-d5")), Move(0, 0, 0, 0));
+}
+
+TEST(OpeningBook, FindsMoveAfterTransposition) {
+
+  OpeningBook openingBook;
+
+  // The Caro-Kann, "e2-e4 c7-c6 d2-d4 d7-d5", with white's moves swapped.
+  auto move = openingBook.findMove(hashAfter("d2-d4 c7-c6 e2-e4"));
+  EXPECT_EQ(move, Move(1, 3, 3, 3));
+}
+
+TEST(OpeningBook, SeedRepeatsTheLine) {
+
+  OpeningBook first;
+  OpeningBook second;
+  first.setSeed(42);
+  second.setSeed(42);
+
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(first.findMove(hashAfter("")), second.findMove(hashAfter("")));
+  }
+}
+
+TEST(OpeningBook, KnowsEveryPositionOfTheBuiltInLines) {
+
+  OpeningBook openingBook;
+
+  for (const auto &opening : openings) {
+    Board board;
+    auto moves = stringToMoves(opening);
+    while (!moves.empty()) {
+      auto move = moves.front();
+      moves.pop();
+      EXPECT_FALSE(openingBook.findMove(board.getHash()) == Move(0, 0, 0, 0));
+      board.calcAndGetLegalMoves(move.startRow, move.startCol);
+      board.makeAMove(move.startRow, move.startCol, move.endRow, move.endCol);
+    }
+  }
+}
+
+TEST(OpeningBook, WeighsMovesByTheLinesPlayingThem) {
+
+  OpeningBook openingBook;
+  openingBook.setBestOnly(true);
+
+  const auto entries = openingBook.findEntries(hashAfter(""));
+  EXPECT_EQ(entries.size(), 4);
+  EXPECT_EQ(openingBook.findMove(hashAfter("")), Move(6, 4, 4, 4));
+}
+
+TEST(OpeningBook, NeverPicksMovesWithoutWeight) {
+
+  BookEntry played;
+  played.key = hashAfter("");
+  played.move = BookEntry::encodeMove(Move(6, 0, 5, 0));
+  played.weight = 3;
+  auto unplayed = played;
+  unplayed.move = BookEntry::encodeMove(Move(6, 7, 5, 7));
+  unplayed.weight = 0;
+  const auto path = testing::TempDir() + "weightedBook.bin";
+  ASSERT_TRUE(BookFile::write(path, {played, unplayed}));
+
+  OpeningBook openingBook;
+  ASSERT_TRUE(openingBook.loadFile(path));
+  EXPECT_EQ(openingBook.findEntries(hashAfter("")).size(), 2);
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(openingBook.findMove(hashAfter("")), Move(6, 0, 5, 0));
+  }
 }
@@ -0,0 +1,159 @@
+#include "../chess/pgn.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+Move decode(Board &board, const std::string &san) {
+  std::string promotionType;
+  return decodeSan(board, san, promotionType);
+}
+
+Board boardAfterSan(const std::vector<std::string> &moves) {
+  Board board;
+  for (const auto &move : moves) {
+    EXPECT_TRUE(playSan(board, move)) << move;
+  }
+  return board;
+}
+
+TEST(PgnTests, DecodesPawnAndPieceMoves) {
+  Board board;
+  EXPECT_EQ(decode(board, "e4"), Move(6, 4, 4, 4));
+  EXPECT_EQ(decode(board, "e3"), Move(6, 4, 5, 4));
+  EXPECT_EQ(decode(board, "Nf3"), Move(7, 6, 5, 5));
+  EXPECT_EQ(decode(board, "e5"), Move(0, 0, 0, 0));
+  EXPECT_EQ(decode(board, "Bc4"), Move(0, 0, 0, 0));
+}
+
+TEST(PgnTests, DecodesCapturesChecksAndCastling) {
+  auto board = boardAfterSan(
+      {"e4", "d5", "exd5", "Qxd5", "Nc3", "Qa5", "Nf3", "Nf6", "Bc4", "e6"});
+  EXPECT_EQ(decode(board, "O-O"), Move(7, 4, 7, 6));
+  EXPECT_EQ(decode(board, "Bb5+"), Move(4, 2, 3, 1));
+  EXPECT_EQ(decode(board, "Bxe6!?"), Move(4, 2, 2, 4));
+  EXPECT_EQ(decode(board, "O-O-O"), Move(0, 0, 0, 0));
+}
+
+TEST(PgnTests, RejectsCastlingWithoutRightsOrThroughCheck) {
+  auto board = boardAfterSan({"e4", "e5", "Nf3", "Nc6", "Bc4", "Bc5", "Kf1",
+                              "Nf6", "Ke1", "d6"});
+  EXPECT_EQ(decode(board, "O-O"), Move(0, 0, 0, 0));
+
+  auto withoutRights = Board::fromFEN("4k3/8/8/8/8/8/8/4K2R w - - 0 1");
+  ASSERT_NE(withoutRights, nullptr);
+  EXPECT_EQ(decode(*withoutRights, "O-O"), Move(0, 0, 0, 0));
+
+  auto inCheck = Board::fromFEN("4k3/4r3/8/8/8/8/8/4K2R w K - 0 1");
+  ASSERT_NE(inCheck, nullptr);
+  EXPECT_EQ(decode(*inCheck, "O-O"), Move(0, 0, 0, 0));
+
+  auto throughCheck = Board::fromFEN("4k3/5r2/8/8/8/8/8/4K2R w K - 0 1");
+  ASSERT_NE(throughCheck, nullptr);
+  EXPECT_EQ(decode(*throughCheck, "O-O"), Move(0, 0, 0, 0));
+
+  auto allowed = Board::fromFEN("4k3/8/8/8/8/8/8/4K2R w K - 0 1");
+  ASSERT_NE(allowed, nullptr);
+  EXPECT_EQ(decode(*allowed, "O-O"), Move(7, 4, 7, 6));
+}
+
+TEST(PgnTests, DisambiguatesByFileAndRank) {
+  auto board = boardAfterSan({"Nf3", "Nf6", "Nc3", "Nc6", "Nd4", "Nd5"});
+  EXPECT_EQ(decode(board, "Nb5"), Move(0, 0, 0, 0));
+  EXPECT_EQ(decode(board, "Ndb5"), Move(4, 3, 3, 1));
+  EXPECT_EQ(decode(board, "Ncb5"), Move(5, 2, 3, 1));
+  EXPECT_EQ(decode(board, "N4b5"), Move(4, 3, 3, 1));
+}
+
+TEST(PgnTests, DecodesEnPassantAndPromotion) {
+  auto board = boardAfterSan({"e4", "a6", "e5", "d5"});
+  EXPECT_EQ(decode(board, "exd6"), Move(3, 4, 2, 3));
+
+  auto promoting =
+      boardAfterSan({"h4", "g5", "hxg5", "Bg7", "g6", "Bf6", "gxh7", "Kf8"});
+  std::string promotionType;
+  EXPECT_EQ(decodeSan(promoting, "hxg8=N", promotionType), Move(1, 7, 0, 6));
+  EXPECT_EQ(promotionType, KNIGHT);
+  EXPECT_TRUE(playSan(promoting, "hxg8=N"));
+  EXPECT_EQ(promoting.getSquare(0, 6).getPiece().getType(), KNIGHT);
+}
+
+TEST(PgnTests, RejectsPawnCapturesOfNothing) {
+  auto board = boardAfterSan({"e4", "Nf6"});
+  EXPECT_EQ(decode(board, "exd5"), Move(0, 0, 0, 0));
+  EXPECT_EQ(decode(board, "exd1"), Move(0, 0, 0, 0));
+  EXPECT_EQ(decode(board, "exf5"), Move(0, 0, 0, 0));
+
+  board = boardAfterSan({"e4", "a6", "e5", "d5", "a3", "a5"});
+  EXPECT_EQ(decode(board, "exd6"), Move(0, 0, 0, 0));
+  EXPECT_EQ(board.toFEN(),
+            "rnbqkbnr/1pp1pppp/8/p2pP3/8/P7/1PPP1PPP/RNBQKBNR w KQkq - 0 4");
+
+  auto blocked = Board::fromFEN("4k3/8/8/8/4p3/8/4P3/4K3 w - - 0 1");
+  ASSERT_NE(blocked, nullptr);
+  EXPECT_EQ(decode(*blocked, "e4"), Move(0, 0, 0, 0));
+  EXPECT_EQ(decode(*blocked, "e3"), Move(6, 4, 5, 4));
+}
+
+TEST(PgnTests, ReadsGamesWithCommentsAndVariations) {
+  std::istringstream input(R"([Event "Test"]
+[White "A \"quoted\" name"]
+[Result "1-0"]
+
+1. e4 {best by test} e5 2.Nf3 (2. f4 exf4 (2... d5) 3. Nf3) 2... Nc6 $1
+; a comment to the end of the line
+3. Bb5 1-0
+
+[Event "Second"]
+1. d4 d5 *
+)");
+  PgnReader reader(input);
+  PgnGame game;
+
+  ASSERT_TRUE(reader.readGame(game));
+  EXPECT_EQ(game.getTag("Event"), "Test");
+  EXPECT_EQ(game.getTag("White"), "A \"quoted\" name");
+  EXPECT_EQ(game.result, "1-0");
+  EXPECT_EQ(game.moves,
+            std::vector<std::string_view>({"e4", "e5", "Nf3", "Nc6", "Bb5"}));
+
+  ASSERT_TRUE(reader.readGame(game));
+  EXPECT_EQ(game.getTag("Event"), "Second");
+  EXPECT_EQ(game.moves, std::vector<std::string_view>({"d4", "d5"}));
+  EXPECT_EQ(game.result, "*");
+
+  EXPECT_FALSE(reader.readGame(game));
+}
+
+TEST(PgnTests, ReadsGamesLargerThanABufferChunk) {
+  std::string text;
+  for (int game = 0; game < 3; game++) {
+    text += "[Event \"Long\"]\n[Result \"1/2-1/2\"]\n\n";
+    for (int move = 1; move <= 4000; move++) {
+      text += std::to_string(move) + ". Nf3 {a comment} Nf6 $2 (" +
+              std::to_string(move) + "... e5) ";
+    }
+    text += "1/2-1/2\n\n";
+  }
+  std::istringstream input(text);
+  PgnReader reader(input);
+  PgnGame game;
+
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(reader.readGame(game));
+    EXPECT_EQ(game.getTag("Event"), "Long");
+    EXPECT_EQ(game.moves.size(), 8000);
+    EXPECT_EQ(game.moves.back(), "Nf6");
+    EXPECT_EQ(game.result, "1/2-1/2");
+  }
+  EXPECT_FALSE(reader.readGame(game));
+}
+
+TEST(PgnTests, ReadsAGameWithoutResult) {
+  std::istringstream input("% an escaped line\n1. e4 e5\n2. Nf3");
+  PgnReader reader(input);
+  PgnGame game;
+
+  ASSERT_TRUE(reader.readGame(game));
+  EXPECT_EQ(game.moves, std::vector<std::string_view>({"e4", "e5", "Nf3"}));
+  EXPECT_EQ(game.result, "");
+  EXPECT_FALSE(reader.readGame(game));
+}
@@ -0,0 +1,135 @@
+#include "../chess/sessionManager.h"
+#include <gtest/gtest.h>
+
+void startGame(SessionManager &manager, SessionId id, int timePerMove,
+               int strengthLevel) {
+  manager.withGame(id, [&](Game &game) {
+    game.newGame(WHITE, timePerMove, false, strengthLevel);
+    game.calcAndGetLegalMoves(6, 4);
+    game.makeAMove(6, 4, 4, 4);
+  });
+}
+
+void waitForMoves(const SessionManager &manager, long moves) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (manager.getStats().movesPlayed < moves &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+}
+
+TEST(SessionManagerTests, PlaysTheMovesOfEverySession) {
+  ThreadPool pool(3);
+  SessionManager manager(pool, 16);
+  std::vector<SessionId> ids;
+  for (int i = 0; i < 8; i++) {
+    ids.push_back(manager.createSession());
+    startGame(manager, ids.back(), 0, 1);
+  }
+
+  std::mutex mutex;
+  std::vector<SessionId> answered;
+  for (auto id : ids) {
+    EXPECT_TRUE(manager.requestComputerMove(
+        id, [&](SessionId id, const Move &move, const GameInfo &gameInfo) {
+          EXPECT_TRUE(move == gameInfo.getLastMove());
+          EXPECT_FALSE(move == Move(0, 0, 0, 0));
+          std::lock_guard<std::mutex> lock(mutex);
+          answered.push_back(id);
+        }));
+  }
+  waitForMoves(manager, static_cast<long>(ids.size()));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  std::sort(begin(answered), end(answered));
+  EXPECT_EQ(answered, ids);
+  for (auto id : ids) {
+    manager.withGame(id,
+                     [](Game &game) { EXPECT_EQ(game.getTurn(), WHITE); });
+  }
+
+  const auto stats = manager.getStats();
+  EXPECT_EQ(stats.sessions, ids.size());
+  EXPECT_EQ(stats.queueDepth, 0u);
+  EXPECT_EQ(stats.movesPlayed, static_cast<long>(ids.size()));
+  EXPECT_EQ(stats.rejected, 0);
+  EXPECT_GE(stats.averageTotalMilliseconds, stats.averageWaitMilliseconds);
+}
+
+TEST(SessionManagerTests, TurnsAwayRequestsWhenTheQueueIsFull) {
+  ThreadPool pool(1);
+  SessionManager manager(pool, 1);
+  const auto slow = manager.createSession();
+  const auto first = manager.createSession();
+  const auto second = manager.createSession();
+  startGame(manager, slow, 500, 0);
+  startGame(manager, first, 0, 1);
+  startGame(manager, second, 0, 1);
+
+  EXPECT_TRUE(manager.requestComputerMove(slow, nullptr));
+  EXPECT_FALSE(manager.requestComputerMove(slow, nullptr));
+  manager.requestComputerMove(first, nullptr);
+  EXPECT_FALSE(manager.requestComputerMove(second, nullptr));
+  EXPECT_GE(manager.getStats().rejected, 1);
+  EXPECT_LE(manager.getStats().queueDepth, 1u);
+}
+
+TEST(SessionManagerTests, ClosedSessionsAreGone) {
+  ThreadPool pool(1);
+  SessionManager manager(pool, 4);
+  const auto slow = manager.createSession();
+  const auto closed = manager.createSession();
+  startGame(manager, slow, 300, 0);
+  startGame(manager, closed, 0, 1);
+
+  bool called = false;
+  EXPECT_TRUE(manager.requestComputerMove(slow, nullptr));
+  EXPECT_TRUE(manager.requestComputerMove(
+      closed,
+      [&](SessionId, const Move &, const GameInfo &) { called = true; }));
+  EXPECT_TRUE(manager.closeSession(closed));
+  EXPECT_FALSE(manager.closeSession(closed));
+  EXPECT_EQ(manager.withGame(closed, [](Game &) {}),
+            SessionAccess::NO_SESSION);
+  EXPECT_FALSE(manager.requestComputerMove(closed, nullptr));
+
+  waitForMoves(manager, 1);
+  EXPECT_EQ(manager.getStats().sessions, 1u);
+  EXPECT_EQ(manager.getStats().queueDepth, 0u);
+  EXPECT_FALSE(called);
+}
+
+TEST(SessionManagerTests, BusyGamesCanBeStopped) {
+  ThreadPool pool(1);
+  SessionManager manager(pool, 4);
+  const auto searching = manager.createSession();
+  const auto waiting = manager.createSession();
+  startGame(manager, searching, 60000, 0);
+  startGame(manager, waiting, 0, 1);
+
+  bool waitingPlayed = false;
+  EXPECT_TRUE(manager.requestComputerMove(searching, nullptr));
+  EXPECT_TRUE(manager.requestComputerMove(
+      waiting, [&](SessionId, const Move &, const GameInfo &) {
+        waitingPlayed = true;
+      }));
+  while (manager.getStats().running == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(manager.withGame(searching, [](Game &) {}), SessionAccess::BUSY);
+  EXPECT_EQ(manager.withGame(waiting, [](Game &) {}), SessionAccess::BUSY);
+
+  EXPECT_TRUE(manager.stopComputerMove(waiting));
+  EXPECT_FALSE(manager.stopComputerMove(waiting));
+  EXPECT_EQ(manager.withGame(waiting, [](Game &) {}), SessionAccess::DONE);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  EXPECT_TRUE(manager.stopComputerMove(searching));
+  waitForMoves(manager, 1);
+  EXPECT_LT(std::chrono::steady_clock::now() - startTime,
+            std::chrono::seconds(10));
+  manager.withGame(searching,
+                   [](Game &game) { EXPECT_EQ(game.getTurn(), WHITE); });
+  EXPECT_FALSE(waitingPlayed);
+}
@@ -0,0 +1,85 @@
+#include "../chess/simd.h"
+#include <gtest/gtest.h>
+#include <random>
+
+class SimdTests : public ::testing::Test {
+
+public:
+  std::mt19937_64 engine = std::mt19937_64(2022);
+  int16_t table[SQUARE_COUNT];
+
+  void fillTable() {
+    std::uniform_int_distribution<int> dist{-4095, 4095};
+    for (auto &value : table) {
+      value = dist(engine);
+    }
+  }
+};
+
+TEST_F(SimdTests, ScalarMaskedSum) {
+  for (int i = 0; i < SQUARE_COUNT; i++) {
+    table[i] = i;
+  }
+  EXPECT_EQ(simd::scalar::maskedSum(0, table), 0);
+  EXPECT_EQ(simd::scalar::maskedSum(0b1011, table), 0 + 1 + 3);
+  EXPECT_EQ(simd::scalar::maskedSum(~Bitboard(0), table), 63 * 64 / 2);
+}
+
+TEST_F(SimdTests, MaskedSumMatchesScalar) {
+  for (int round = 0; round < 1000; round++) {
+    fillTable();
+    const Bitboard bits = engine();
+    EXPECT_EQ(simd::maskedSum(bits, table),
+              simd::scalar::maskedSum(bits, table));
+  }
+}
+
+TEST_F(SimdTests, MaskedSumExtremeValues) {
+  for (auto &value : table) {
+    value = -4095;
+  }
+  EXPECT_EQ(simd::maskedSum(~Bitboard(0), table),
+            simd::scalar::maskedSum(~Bitboard(0), table));
+  for (auto &value : table) {
+    value = 4095;
+  }
+  EXPECT_EQ(simd::maskedSum(~Bitboard(0), table),
+            simd::scalar::maskedSum(~Bitboard(0), table));
+  EXPECT_EQ(simd::maskedSum(Bitboard(1) << 63, table), 4095);
+}
+
+#if defined(SIMD_SSE2)
+TEST_F(SimdTests, Sse2MatchesScalar) {
+  for (int round = 0; round < 1000; round++) {
+    fillTable();
+    const Bitboard bits = engine();
+    EXPECT_EQ(simd::sse2::maskedSum(bits, table),
+              simd::scalar::maskedSum(bits, table));
+  }
+}
+#endif
+
+#if defined(SIMD_AVX2)
+TEST_F(SimdTests, Avx2MatchesScalar) {
+  if (!simd::avx2::isSupported()) {
+    GTEST_SKIP();
+  }
+  for (int round = 0; round < 1000; round++) {
+    fillTable();
+    const Bitboard bits = engine();
+    EXPECT_EQ(simd::avx2::maskedSum(bits, table),
+              simd::scalar::maskedSum(bits, table));
+  }
+}
+#endif
+
+#if defined(SIMD_WASM128)
+TEST_F(SimdTests, Wasm128MatchesScalar) {
+  for (int round = 0; round < 1000; round++) {
+    fillTable();
+    const Bitboard bits = engine();
+    EXPECT_EQ(simd::wasm128::maskedSum(bits, table),
+              simd::scalar::maskedSum(bits, table));
+  }
+}
+#endif
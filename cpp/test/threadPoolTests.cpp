@@ -0,0 +1,78 @@
+#include "../chess/threadPool.h"
+#include <gtest/gtest.h>
+
+TEST(ThreadPoolTests, RunsEveryTask) {
+  std::atomic<int> done(0);
+  {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4);
+    EXPECT_EQ(pool.getWorkerIndex(), -1);
+    for (int i = 0; i < 1000; i++) {
+      pool.submit([&done]() { done++; });
+    }
+  }
+  EXPECT_EQ(done, 1000);
+}
+
+TEST(ThreadPoolTests, InteractiveTasksGoFirst) {
+  std::mutex mutex;
+  std::condition_variable released;
+  bool release = false;
+  std::vector<TaskPriority> order;
+  {
+    ThreadPool pool(1);
+    pool.submit([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      released.wait(lock, [&]() { return release; });
+    });
+    for (auto priority :
+         {TaskPriority::BATCH, TaskPriority::BATCH, TaskPriority::INTERACTIVE,
+          TaskPriority::BATCH, TaskPriority::INTERACTIVE}) {
+      pool.submit(
+          [&, priority]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(priority);
+          },
+          priority);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      release = true;
+    }
+    released.notify_all();
+  }
+
+  ASSERT_EQ(order.size(), 5u);
+  EXPECT_EQ(order[0], TaskPriority::INTERACTIVE);
+  EXPECT_EQ(order[1], TaskPriority::INTERACTIVE);
+  EXPECT_EQ(order[2], TaskPriority::BATCH);
+}
+
+// The worker that submits the tasks waits for them, so the other workers
+// have to steal every one of them.
+TEST(ThreadPoolTests, IdleWorkersStealTasks) {
+  std::atomic<int> done(0);
+  std::atomic<int> ranOnSubmitter(0);
+  {
+    ThreadPool pool(3);
+    pool.submit([&]() {
+      const auto submitter = pool.getWorkerIndex();
+      EXPECT_GE(submitter, 0);
+      for (int i = 0; i < 20; i++) {
+        pool.submit([&, submitter]() {
+          if (pool.getWorkerIndex() == submitter) {
+            ranOnSubmitter++;
+          }
+          done++;
+        });
+      }
+      const auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (done < 20 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  EXPECT_EQ(done, 20);
+  EXPECT_EQ(ranOnSubmitter, 0);
+}
@@ -0,0 +1,61 @@
+#include "../chess/timeManager.h"
+#include <gtest/gtest.h>
+
+using std::chrono::milliseconds;
+
+TEST(TimeManagerTests, FixedLimits) {
+  TimeManager timeManager(milliseconds(500), milliseconds(1000));
+  timeManager.start();
+  EXPECT_TRUE(timeManager.canStartIteration());
+  EXPECT_FALSE(timeManager.shouldAbort(TimeManager::CHECK_INTERVAL));
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(500));
+  EXPECT_EQ(timeManager.getHardLimit(), milliseconds(1000));
+}
+
+TEST(TimeManagerTests, ClockWithMovesToGo) {
+  GameClock clock;
+  clock.remaining = milliseconds(60020);
+  clock.increment = milliseconds(1000);
+  clock.movesToGo = 20;
+
+  auto timeManager = TimeManager::fromClock(clock);
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(4000));
+  EXPECT_EQ(timeManager.getHardLimit(), milliseconds(12000));
+}
+
+TEST(TimeManagerTests, ClockNeverSpendsMoreThanHalf) {
+  GameClock clock;
+  clock.remaining = milliseconds(1020);
+  clock.increment = milliseconds(2000);
+
+  auto timeManager = TimeManager::fromClock(clock);
+  EXPECT_EQ(timeManager.getHardLimit(), milliseconds(500));
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(500));
+}
+
+TEST(TimeManagerTests, StableBestMoveSpendsLess) {
+  TimeManager timeManager(milliseconds(1000), milliseconds(3000));
+  timeManager.start();
+  timeManager.completeIteration(true, 10);
+  timeManager.completeIteration(false, 10);
+  timeManager.completeIteration(false, 10);
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(700));
+
+  timeManager.completeIteration(false, 10);
+  timeManager.completeIteration(false, 10);
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(400));
+
+  timeManager.completeIteration(true, 10);
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(1000));
+}
+
+TEST(TimeManagerTests, ScoreDropSpendsMore) {
+  TimeManager timeManager(milliseconds(1000), milliseconds(1500));
+  timeManager.start();
+  timeManager.completeIteration(true, 10);
+  timeManager.completeIteration(true, -15);
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(1500));
+
+  timeManager.start();
+  EXPECT_EQ(timeManager.getSoftLimit(), milliseconds(1000));
+}
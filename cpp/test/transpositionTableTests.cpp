@@ -0,0 +1,62 @@
+#include "../chess/transpositionTable.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(TranspositionTableTests, FindsStoredPosition) {
+  TranspositionTable table(1024);
+  table.store(0x1234567890abcdefULL, 5, -42, Bound::LOWER, Move(6, 4, 4, 4));
+
+  const auto entry = table.probe(0x1234567890abcdefULL);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(entry->depth, 5);
+  EXPECT_EQ(entry->score, -42);
+  EXPECT_EQ(entry->bound, Bound::LOWER);
+  EXPECT_EQ(entry->getMove(), Move(6, 4, 4, 4));
+}
+
+TEST(TranspositionTableTests, MissesUnknownPosition) {
+  TranspositionTable table(1024);
+  EXPECT_FALSE(table.probe(7));
+  EXPECT_FALSE(table.probe(0));
+}
+
+TEST(TranspositionTableTests, NewEntryReplacesOldOneInItsSlot) {
+  TranspositionTable table(1024);
+  table.store(5, 3, 10, Bound::EXACT, Move(1, 1, 2, 2));
+  table.store(5 + 1024, 1, 20, Bound::UPPER, Move(3, 3, 4, 4));
+
+  EXPECT_FALSE(table.probe(5));
+  ASSERT_TRUE(table.probe(5 + 1024));
+  EXPECT_EQ(table.probe(5 + 1024)->score, 20);
+}
+
+TEST(TranspositionTableTests, ClearForgetsEverything) {
+  TranspositionTable table(1024);
+  table.store(99, 3, 10, Bound::EXACT, Move(1, 1, 2, 2));
+  table.clear();
+  EXPECT_FALSE(table.probe(99));
+}
+
+TEST(TranspositionTableTests, SharedTableNeverReturnsTornEntries) {
+  TranspositionTable table(16);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&table, t]() {
+      for (std::uint64_t key = 1; key < 20000; key++) {
+        table.store(key, t + 1, static_cast<int>(key) * (t + 1), Bound::EXACT,
+                    Move(t, t, t + 1, t + 1));
+        const auto entry = table.probe(key ^ 1);
+        if (entry) {
+          const auto writer = entry->depth - 1;
+          EXPECT_EQ(entry->score, static_cast<int>(key ^ 1) * (writer + 1));
+          EXPECT_EQ(entry->getMove(),
+                    Move(writer, writer, writer + 1, writer + 1));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
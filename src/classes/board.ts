@@ -17,6 +17,10 @@ import {
 	gameStatus
 } from '../stores/modals';
 import { setPlayerPerspective, createNewGame, usingTouch } from '../stores/game';
+import { threadsAvailable } from '../functions/module';
+
+const canSearchInWorker = threadsAvailable;
+const searchSliceMicroseconds = 10000;
 
 class Board {
 	canvas: HTMLCanvasElement;
@@ -35,6 +39,7 @@ class Board {
 
 	constructor(gamePtr: GamePtr, images: Images) {
 		this.gamePtr = gamePtr;
+		this.gamePtr.setPondering(canSearchInWorker);
 		this.squares = this.gamePtr.getSquares();
 		this.images = images;
 		this.playerPerspective = 'White';
@@ -50,7 +55,7 @@ class Board {
 		});
 
 		createNewGame.set((timePerMove: number, useOpeningBook: boolean) => {
-			this.gamePtr.newGame(this.playerPerspective, timePerMove, useOpeningBook);
+			this.gamePtr.newGame(this.playerPerspective, timePerMove, useOpeningBook, 0);
 			if (this.playerPerspective === 'Black') {
 				this.makeComputerMove();
 			}
@@ -353,16 +358,46 @@ class Board {
 	makeComputerMove = (): void => {
 		this.drawBoard();
 		setTimeout(() => {
-			if (get(gameStatus) === '') {
-				const { status, squares, lastMove } = this.gamePtr.makeComputerMove();
-				this.lastMove = lastMove;
-				this.squares = squares;
-				gameStatus.set(status);
-				this.drawBoard();
+			if (get(gameStatus) !== '') {
+				return;
+			}
+			if (canSearchInWorker) {
+				this.gamePtr.startComputerMove();
+				this.waitForComputerMove();
+			} else {
+				this.stepComputerMove();
 			}
 		}, 100);
 	};
 
+	// Without SharedArrayBuffer getModule loads the engine built without
+	// threads, so the search runs in short slices between frames instead.
+	stepComputerMove = (): void => {
+		if (!this.gamePtr.stepComputerMove(searchSliceMicroseconds)) {
+			setTimeout(this.stepComputerMove, 0);
+			return;
+		}
+		this.playComputerMove();
+	};
+
+	playComputerMove = (): void => {
+		const { status, squares, lastMove } = this.gamePtr.waitComputerMove();
+		this.lastMove = lastMove;
+		this.squares = squares;
+		gameStatus.set(status);
+		this.drawBoard();
+	};
+
+	waitForComputerMove = (): void => {
+		setTimeout(() => {
+			if (!this.gamePtr.isComputerMoveReady()) {
+				this.waitForComputerMove();
+				return;
+			}
+			this.playComputerMove();
+		}, 50);
+	};
+
 	flipPosition = (row: number, col: number): BoardPosition =>
 		this.playerPerspective === 'White' ? { row, col } : { row: 7 - row, col: 7 - col };
 
@@ -1,6 +1,12 @@
-import Module from '../wasm/chess.js';
 import type { TModule } from '../types/chess';
 
-export const getModule = (): TModule => {
+// The engine built with threads needs SharedArrayBuffer to start, hosts
+// without it load the build without threads.
+export const threadsAvailable = typeof SharedArrayBuffer !== 'undefined';
+
+export const getModule = async (): Promise<TModule> => {
+	const { default: Module } = threadsAvailable
+		? await import('../wasm/chess.js')
+		: await import('../wasm/chessSingleThread.js');
 	return Module;
 };
@@ -33,6 +33,48 @@ export type Move = {
 	endCol: number;
 };
 
+export type SearchProgress = {
+	depth: number;
+	nodes: number;
+	score: number;
+	bestMove: Move;
+};
+
+export type AnalysisLine = {
+	moves: {
+		get: (i: number) => Move;
+		size: () => number;
+	};
+	depth: number;
+	centipawns: number;
+	mateIn: number;
+};
+
+export type IterationStats = {
+	depth: number;
+	nodes: number;
+	milliseconds: number;
+	score: number;
+};
+
+export type SearchStats = {
+	depth: number;
+	nodes: number;
+	milliseconds: number;
+	nodesPerSecond: number;
+	effectiveBranchingFactor: number;
+	tableProbes: number;
+	tableHits: number;
+	tableHitRate: number;
+	cutoffs: number;
+	firstMoveCutoffs: number;
+	firstMoveCutoffRate: number;
+	iterations: {
+		get: (i: number) => IterationStats;
+		size: () => number;
+	};
+};
+
 export type GamePtr = {
 	calcAndGetLegalMoves: (row: number, col: number) => SquareArray;
 	getSquares: () => RowArray;
@@ -44,8 +86,31 @@ export type GamePtr = {
 	) => { status: string; squares: RowArray; lastMove: Move };
 	getTurn: () => string;
 	setPromotionType: (type: string) => void;
-	newGame: (playerColor: string, timePerMove: number, useOpeningBook: boolean) => void;
+	newGame: (
+		playerColor: string,
+		timePerMove: number,
+		useOpeningBook: boolean,
+		strengthLevel: number
+	) => void;
+	setComputerClock: (remainingTime: number, increment: number, movesToGo: number) => void;
 	makeComputerMove: () => { status: string; squares: RowArray; lastMove: Move };
+	startComputerMove: () => void;
+	stepComputerMove: (budgetMicroseconds: number) => boolean;
+	isComputerMoveReady: () => boolean;
+	waitComputerMove: () => { status: string; squares: RowArray; lastMove: Move };
+	getSearchProgress: () => SearchProgress;
+	getSearchStats: () => SearchStats;
+	setMultiPv: (count: number) => void;
+	getAnalysisLines: () => {
+		get: (i: number) => AnalysisLine;
+		size: () => number;
+	};
+	stopSearch: () => void;
+	setPondering: (enabled: boolean) => void;
+	getPonderMove: () => Move;
+	setSeed: (seed: number) => void;
+	loadOpeningBook: (path: string) => boolean;
+	setBestBookMoves: (bestOnly: boolean) => void;
 };
 
 export type TModule = {